@@ -121,17 +121,14 @@ void ScreenAlignedQuad::initialize()
 void ScreenAlignedQuad::draw()
 {
     if (m_texture)
-	{
-        glActiveTexture(GL_TEXTURE0 + m_samplerIndex);
-        m_texture->bind();
-	}
+        m_texture->bindActive(GL_TEXTURE0 + m_samplerIndex);
 
     m_program->use();
     m_vao->drawArrays(GL_TRIANGLE_STRIP, 0, 4);
     m_program->release();
 
 	if (m_texture)
-		m_texture->unbind();
+		m_texture->unbindActive(GL_TEXTURE0 + m_samplerIndex);
 }
 
 void ScreenAlignedQuad::setTexture(Texture* texture)
@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+#include <glbinding/Binding.h>
+#include <glbinding/ContextHandle.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h> // specifies APIENTRY, should be after Error.h include,
+// which requires APIENTRY in windows..
+
+#include <globjects/globjects.h>
+#include <globjects/logging.h>
+
+
+using namespace gl;
+using namespace globjects;
+
+namespace
+{
+
+const int contextCount = 4;
+
+/** Lets every thread switch between all registered contexts and returns the switches per second.
+*/
+double benchmark(const std::vector<glbinding::ContextHandle> & contexts, const int threadCount, const int switchesPerThread)
+{
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&contexts, &start, t, switchesPerThread]()
+        {
+            while (!start.load())
+                std::this_thread::yield();
+
+            for (int i = 0; i < switchesPerThread; ++i)
+                setContext(contexts[static_cast<std::size_t>(i + t) % contexts.size()]);
+        });
+    }
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    start.store(true);
+
+    for (std::thread & thread : threads)
+        thread.join();
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - t0;
+
+    return static_cast<double>(threadCount) * switchesPerThread / elapsed.count();
+}
+
+}
+
+/** This example measures the contention of switching between registered contexts,
+    i.e., of setContext() called from N threads at once. Only the registries are
+    switched; no OpenGL context is made current on the worker threads. Note that
+    setContext() includes glbinding's own context lookup.
+
+    Usage: context-switch [max thread count = 16] [switches per thread = 1000000]
+*/
+int main(int argc, char * argv[])
+{
+    const int maxThreadCount = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int switchesPerThread = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    if (!glfwInit())
+        return 1;
+
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, false);
+
+    std::vector<GLFWwindow *> windows;
+    std::vector<glbinding::ContextHandle> contexts;
+
+    for (int i = 0; i < contextCount; ++i)
+    {
+        GLFWwindow * window = glfwCreateWindow(1, 1, "", nullptr, nullptr);
+
+        if (!window)
+        {
+            critical() << "Context creation failed - terminate execution.";
+            glfwTerminate();
+            return 1;
+        }
+
+        glfwMakeContextCurrent(window);
+
+        glbinding::Binding::initialize(false);
+        init();
+
+        windows.push_back(window);
+        contexts.push_back(glbinding::getCurrentContext());
+    }
+
+    glfwMakeContextCurrent(nullptr);
+
+    std::cout << "Switching between " << contextCount << " contexts, " << switchesPerThread << " switches per thread" << std::endl;
+
+    for (int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        const double switchesPerSecond = benchmark(contexts, threadCount, switchesPerThread);
+
+        std::cout << std::setw(4) << threadCount << " threads: "
+            << std::fixed << std::setprecision(2) << switchesPerSecond / 1e6 << " M switches/s" << std::endl;
+    }
+
+    for (GLFWwindow * window : windows)
+        glfwDestroyWindow(window);
+
+    glfwTerminate();
+
+    return 0;
+}
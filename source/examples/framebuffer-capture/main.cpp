@@ -0,0 +1,181 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+#include <glbinding/Binding.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h> // specifies APIENTRY, should be after Error.h include,
+// which requires APIENTRY in windows..
+
+#include <globjects/globjects.h>
+#include <globjects/logging.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/Framebuffer.h>
+#include <globjects/FramebufferCapture.h>
+#include <globjects/Texture.h>
+
+
+using namespace gl;
+using namespace globjects;
+
+namespace
+{
+
+const int width = 1920;
+const int height = 1080;
+
+/** Stands in for the rendering of a frame: clears the color attachment clearsPerFrame times.
+*/
+void render(Framebuffer * fbo, const int frame, const int clearsPerFrame)
+{
+    fbo->bind(GL_FRAMEBUFFER);
+
+    for (int i = 0; i < clearsPerFrame; ++i)
+    {
+        const float value = static_cast<float>((frame + i) % 256) / 255.f;
+
+        fbo->clearColor(value, 1.f - value, 0.5f, 1.f);
+        fbo->clear(GL_COLOR_BUFFER_BIT);
+    }
+}
+
+/** Renders and reads back each frame with Framebuffer::readPixels, which waits for the frame to finish. Returns the frames per second.
+*/
+double benchmarkSynchronous(Framebuffer * fbo, const int frames, const int clearsPerFrame, unsigned long long & checksum)
+{
+    std::vector<unsigned char> pixels(width * height * 4);
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        render(fbo, frame, clearsPerFrame);
+
+        fbo->readPixels(GL_COLOR_ATTACHMENT0, { { 0, 0, width, height } }, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        checksum += pixels.front();
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - t0;
+
+    return frames / elapsed.count();
+}
+
+/** Renders and reads back each frame with a FramebufferCapture, which maps a frame bufferCount - 1 frames later. Returns the frames per second.
+*/
+double benchmarkCapture(Framebuffer * fbo, const int frames, const int clearsPerFrame, const unsigned int bufferCount, unsigned long long & checksum)
+{
+    ref_ptr<FramebufferCapture> capture = new FramebufferCapture(bufferCount);
+
+    capture->setCallback([&checksum](const FramebufferCapture::Frame & frame)
+    {
+        checksum += *static_cast<const unsigned char *>(frame.data);
+    });
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        render(fbo, frame, clearsPerFrame);
+
+        capture->capture(fbo, GL_COLOR_ATTACHMENT0, { { 0, 0, width, height } }, GL_RGBA, GL_UNSIGNED_BYTE);
+    }
+
+    // all frames are delivered, as with the synchronous read back
+    capture->flush();
+
+    const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - t0;
+
+    return frames / elapsed.count();
+}
+
+void report(const std::string & method, const double framesPerSecond)
+{
+    std::cout << std::setw(24) << std::left << method << std::right
+        << std::fixed << std::setprecision(1) << std::setw(8) << framesPerSecond << " fps"
+        << std::setprecision(2) << std::setw(8) << 1000.0 / framesPerSecond << " ms/frame" << std::endl;
+}
+
+}
+
+/** This example compares reading back every rendered frame synchronously, i.e.,
+    with Framebuffer::readPixels into client memory, to the pipelined read back
+    of FramebufferCapture through a ring of pixel pack buffers. Each frame of
+    1920x1080 RGBA8 pixels is rendered into an offscreen framebuffer and read
+    back completely; the frame rate includes delivering all frames.
+
+    Usage: framebuffer-capture [frames = 500] [clears per frame = 16]
+*/
+int main(int argc, char * argv[])
+{
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 500;
+    const int clearsPerFrame = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    if (!glfwInit())
+        return 1;
+
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, false);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, true);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow * window = glfwCreateWindow(1, 1, "", nullptr, nullptr);
+
+    if (!window)
+    {
+        critical() << "Context creation failed - terminate execution.";
+        glfwTerminate();
+        return 1;
+    }
+
+    glfwMakeContextCurrent(window);
+
+    glbinding::Binding::initialize(false);
+    init();
+
+    {
+        ref_ptr<Texture> color = Texture::createDefault(GL_TEXTURE_2D);
+        color->image2D(0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        ref_ptr<Framebuffer> fbo = new Framebuffer();
+        fbo->attachTexture(GL_COLOR_ATTACHMENT0, color);
+        fbo->printStatus(true);
+
+        unsigned long long checksum = 0;
+
+        std::cout << "Reading back " << frames << " frames of " << width << "x" << height << " RGBA8, "
+            << clearsPerFrame << " clears per frame" << std::endl;
+
+        // warm up, e.g., driver allocations and the first mapping of each buffer
+        benchmarkSynchronous(fbo, 10, clearsPerFrame, checksum);
+        benchmarkCapture(fbo, 10, clearsPerFrame, 3, checksum);
+
+        report("readPixels", benchmarkSynchronous(fbo, frames, clearsPerFrame, checksum));
+
+        for (unsigned int bufferCount = 2; bufferCount <= 4; ++bufferCount)
+        {
+            std::stringstream method;
+            method << "FramebufferCapture(" << bufferCount << ")";
+
+            report(method.str(), benchmarkCapture(fbo, frames, clearsPerFrame, bufferCount, checksum));
+        }
+
+        // keeps the read back data alive
+        std::cout << "checksum " << checksum << std::endl;
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string & filePath)
+:   m_filePath(filePath)
+,   m_data(nullptr)
+,   m_size(0)
+#ifdef _WIN32
+,   m_fileHandle(INVALID_HANDLE_VALUE)
+,   m_mappingHandle(nullptr)
+#else
+,   m_fileDescriptor(-1)
+#endif
+,   m_valid(false)
+{
+    m_valid = map();
+
+    if (!m_valid)
+        unmap();
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+bool MappedFile::isValid() const
+{
+    return m_valid;
+}
+
+const std::string & MappedFile::filePath() const
+{
+    return m_filePath;
+}
+
+const char * MappedFile::data() const
+{
+    return m_data;
+}
+
+size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::map()
+{
+    m_fileHandle = CreateFileA(m_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr
+        , OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "Opening file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_fileHandle, &size) || size.QuadPart == 0)
+    {
+        std::cerr << "File \"" << m_filePath << "\" is empty." << std::endl;
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+        std::cerr << "Mapping file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    m_data = static_cast<const char *>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        std::cerr << "Mapping file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    return true;
+}
+
+void MappedFile::unmap()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(m_fileHandle);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mappingHandle = nullptr;
+    m_fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MappedFile::map()
+{
+    m_fileDescriptor = open(m_filePath.c_str(), O_RDONLY);
+
+    if (m_fileDescriptor < 0)
+    {
+        std::cerr << "Opening file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(m_fileDescriptor, &status) != 0 || status.st_size == 0)
+    {
+        std::cerr << "File \"" << m_filePath << "\" is empty." << std::endl;
+        return false;
+    }
+
+    void * data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Mapping file \"" << m_filePath << "\" failed." << std::endl;
+        return false;
+    }
+
+    m_data = static_cast<const char *>(data);
+    m_size = static_cast<size_t>(status.st_size);
+
+    // levels are read front to back exactly once
+    madvise(data, m_size, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void MappedFile::unmap()
+{
+    if (m_data)
+        munmap(const_cast<char *>(m_data), m_size);
+    if (m_fileDescriptor >= 0)
+        close(m_fileDescriptor);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_fileDescriptor = -1;
+}
+
+#endif
@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+
+/** Read-only memory mapping of a whole file.
+    The mapped bytes can be passed directly to OpenGL upload functions, thus
+    avoiding an intermediate copy as done by RawFile.
+*/
+class MappedFile
+{
+public:
+    MappedFile(const std::string & filePath);
+    virtual ~MappedFile();
+
+    const char * data() const;
+    size_t size() const;
+
+    bool isValid() const;
+    const std::string & filePath() const;
+
+    // owns the mapping, which would be unmapped twice by a copy
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+protected:
+    bool map();
+    void unmap();
+
+protected:
+    const std::string m_filePath;
+
+    const char * m_data;
+    size_t m_size;
+
+#ifdef _WIN32
+    void * m_fileHandle;
+    void * m_mappingHandle;
+#else
+    int m_fileDescriptor;
+#endif
+
+    bool m_valid;
+};
@@ -0,0 +1,527 @@
+
+#include "TextureContainer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <globjects/Buffer.h>
+#include <globjects/Texture.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+const unsigned char KTX1Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+const unsigned char KTX2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+const unsigned char DDSIdentifier[4] = { 'D', 'D', 'S', ' ' };
+
+const uint32_t KTX1Endianness = 0x04030201;
+
+const uint32_t DDSD_DEPTH = 0x800000;
+const uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+const uint32_t DDPF_FOURCC = 0x4;
+const uint32_t DDPF_RGB = 0x40;
+const uint32_t DDSCAPS2_CUBEMAP = 0x200;
+const uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+const uint32_t DDS_DIMENSION_TEXTURE3D = 4;
+
+uint32_t fourCC(const char (&code)[5])
+{
+    return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8
+        | static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+}
+
+template <typename T>
+T read(const char * data, const size_t offset)
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+GLsizei mipmapExtent(const uint32_t extent, const GLint level)
+{
+    return std::max(static_cast<GLsizei>(extent >> level), 1);
+}
+
+}
+
+
+TextureContainer::TextureContainer(const std::string & filePath)
+:   m_file(filePath)
+,   m_target(GL_TEXTURE_2D)
+,   m_internalFormat(GL_NONE)
+,   m_format(GL_NONE)
+,   m_type(GL_NONE)
+,   m_compressed(false)
+,   m_blockSize(0)
+,   m_bytesPerPixel(0)
+,   m_unpackAlignment(1)
+,   m_valid(false)
+{
+    if (!m_file.isValid())
+        return;
+
+    const char * data = m_file.data();
+    const size_t size = m_file.size();
+
+    if (size >= sizeof(KTX1Identifier) && std::memcmp(data, KTX1Identifier, sizeof(KTX1Identifier)) == 0)
+        m_valid = readKTX1();
+    else if (size >= sizeof(KTX2Identifier) && std::memcmp(data, KTX2Identifier, sizeof(KTX2Identifier)) == 0)
+        m_valid = readKTX2();
+    else if (size >= sizeof(DDSIdentifier) && std::memcmp(data, DDSIdentifier, sizeof(DDSIdentifier)) == 0)
+        m_valid = readDDS();
+    else
+        std::cerr << "File \"" << filePath << "\" is neither a KTX nor a DDS file." << std::endl;
+
+    if (!m_valid)
+        m_levels.clear();
+}
+
+TextureContainer::~TextureContainer()
+{
+}
+
+bool TextureContainer::isValid() const
+{
+    return m_valid;
+}
+
+GLenum TextureContainer::target() const
+{
+    return m_target;
+}
+
+GLenum TextureContainer::internalFormat() const
+{
+    return m_internalFormat;
+}
+
+GLenum TextureContainer::format() const
+{
+    return m_format;
+}
+
+GLenum TextureContainer::type() const
+{
+    return m_type;
+}
+
+bool TextureContainer::isCompressed() const
+{
+    return m_compressed;
+}
+
+const std::vector<TextureContainer::Level> & TextureContainer::levels() const
+{
+    return m_levels;
+}
+
+globjects::Texture * TextureContainer::createTexture() const
+{
+    if (!m_valid)
+        return nullptr;
+
+    globjects::Texture * texture = globjects::Texture::createDefault(m_target);
+
+    if (m_levels.size() > 1)
+        texture->setParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+    upload(texture);
+
+    return texture;
+}
+
+void TextureContainer::upload(globjects::Texture * texture) const
+{
+    assert(texture != nullptr);
+    assert(texture->target() == m_target);
+
+    if (!m_valid)
+        return;
+
+    // the level pointers address client memory, i.e., the mapped file
+    globjects::Buffer::unbind(GL_PIXEL_UNPACK_BUFFER);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, m_unpackAlignment);
+
+    const bool is3D = m_target != GL_TEXTURE_2D;
+
+    if (m_compressed)
+    {
+        texture->setParameter(GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(0));
+        texture->setParameter(GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_levels.size() - 1));
+
+        for (const Level & level : m_levels)
+        {
+            if (is3D)
+                texture->compressedImage3D(level.level, m_internalFormat, glm::ivec3(level.width, level.height, level.depth), 0, level.size, level.data);
+            else
+                texture->compressedImage2D(level.level, m_internalFormat, glm::ivec2(level.width, level.height), 0, level.size, level.data);
+        }
+    }
+    else
+    {
+        const GLsizei levelCount = static_cast<GLsizei>(m_levels.size());
+        const Level & base = m_levels.front();
+
+        if (is3D)
+            texture->storage3D(levelCount, m_internalFormat, glm::ivec3(base.width, base.height, base.depth));
+        else
+            texture->storage2D(levelCount, m_internalFormat, glm::ivec2(base.width, base.height));
+
+        for (const Level & level : m_levels)
+        {
+            if (is3D)
+                texture->subImage3D(level.level, glm::ivec3(0), glm::ivec3(level.width, level.height, level.depth), m_format, m_type, level.data);
+            else
+                texture->subImage2D(level.level, glm::ivec2(0), glm::ivec2(level.width, level.height), m_format, m_type, level.data);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+bool TextureContainer::readKTX1()
+{
+    const char * data = m_file.data();
+    const size_t size = m_file.size();
+
+    const size_t headerSize = 64;
+    if (size < headerSize)
+        return false;
+
+    if (read<uint32_t>(data, 12) != KTX1Endianness)
+    {
+        std::cerr << "KTX file \"" << m_file.filePath() << "\" has foreign endianness." << std::endl;
+        return false;
+    }
+
+    const uint32_t glType = read<uint32_t>(data, 16);
+    const uint32_t glFormat = read<uint32_t>(data, 24);
+    const uint32_t glInternalFormat = read<uint32_t>(data, 28);
+    const uint32_t width = read<uint32_t>(data, 36);
+    const uint32_t height = read<uint32_t>(data, 40);
+    const uint32_t depth = read<uint32_t>(data, 44);
+    const uint32_t arrayElements = read<uint32_t>(data, 48);
+    const uint32_t faces = read<uint32_t>(data, 52);
+    const uint32_t levels = std::max(read<uint32_t>(data, 56), 1u);
+    const uint32_t keyValueBytes = read<uint32_t>(data, 60);
+
+    if (faces != 1 || height == 0 || (depth > 0 && arrayElements > 0))
+    {
+        std::cerr << "KTX file \"" << m_file.filePath() << "\" is not a 2D, 2D array, or 3D texture." << std::endl;
+        return false;
+    }
+
+    m_target = depth > 0 ? GL_TEXTURE_3D : (arrayElements > 0 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D);
+    m_internalFormat = static_cast<GLenum>(glInternalFormat);
+    m_format = static_cast<GLenum>(glFormat);
+    m_type = static_cast<GLenum>(glType);
+    m_compressed = glType == 0;
+    m_unpackAlignment = 4; // KTX1 pads rows to four bytes
+
+    size_t offset = headerSize + keyValueBytes;
+
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        if (offset + 4 > size)
+            return false;
+
+        const uint32_t imageSize = read<uint32_t>(data, offset);
+        offset += 4;
+
+        if (offset + imageSize > size)
+            return false;
+
+        Level level;
+        level.level = static_cast<GLint>(i);
+        level.width = mipmapExtent(width, level.level);
+        level.height = mipmapExtent(height, level.level);
+        level.depth = m_target == GL_TEXTURE_3D ? mipmapExtent(depth, level.level) : std::max(static_cast<GLsizei>(arrayElements), 1);
+        level.data = data + offset;
+        level.size = static_cast<GLsizei>(imageSize);
+
+        m_levels.push_back(level);
+
+        offset += (imageSize + 3) & ~3u;
+    }
+
+    return true;
+}
+
+bool TextureContainer::readKTX2()
+{
+    const char * data = m_file.data();
+    const size_t size = m_file.size();
+
+    const size_t headerSize = 80;
+    if (size < headerSize)
+        return false;
+
+    const uint32_t vkFormat = read<uint32_t>(data, 12);
+    const uint32_t width = read<uint32_t>(data, 20);
+    const uint32_t height = read<uint32_t>(data, 24);
+    const uint32_t depth = read<uint32_t>(data, 28);
+    const uint32_t layers = read<uint32_t>(data, 32);
+    const uint32_t faces = read<uint32_t>(data, 36);
+    const uint32_t levels = std::max(read<uint32_t>(data, 40), 1u);
+    const uint32_t supercompressionScheme = read<uint32_t>(data, 44);
+
+    if (supercompressionScheme != 0)
+    {
+        std::cerr << "KTX2 file \"" << m_file.filePath() << "\" uses supercompression, which is not supported." << std::endl;
+        return false;
+    }
+
+    if (faces != 1 || height == 0 || (depth > 0 && layers > 0))
+    {
+        std::cerr << "KTX2 file \"" << m_file.filePath() << "\" is not a 2D, 2D array, or 3D texture." << std::endl;
+        return false;
+    }
+
+    if (!setFormatFromVulkan(vkFormat))
+    {
+        std::cerr << "KTX2 file \"" << m_file.filePath() << "\" has unsupported format " << vkFormat << "." << std::endl;
+        return false;
+    }
+
+    m_target = depth > 0 ? GL_TEXTURE_3D : (layers > 0 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D);
+
+    const size_t levelIndexSize = 24;
+    if (headerSize + levels * levelIndexSize > size)
+        return false;
+
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        const uint64_t byteOffset = read<uint64_t>(data, headerSize + i * levelIndexSize);
+        const uint64_t byteLength = read<uint64_t>(data, headerSize + i * levelIndexSize + 8);
+
+        if (byteOffset + byteLength > size)
+            return false;
+
+        Level level;
+        level.level = static_cast<GLint>(i);
+        level.width = mipmapExtent(width, level.level);
+        level.height = mipmapExtent(height, level.level);
+        level.depth = m_target == GL_TEXTURE_3D ? mipmapExtent(depth, level.level) : std::max(static_cast<GLsizei>(layers), 1);
+        level.data = data + byteOffset;
+        level.size = static_cast<GLsizei>(byteLength);
+
+        m_levels.push_back(level);
+    }
+
+    return true;
+}
+
+bool TextureContainer::readDDS()
+{
+    const char * data = m_file.data();
+    const size_t size = m_file.size();
+
+    size_t offset = 128;
+    if (size < offset)
+        return false;
+
+    const uint32_t flags = read<uint32_t>(data, 8);
+    const uint32_t height = read<uint32_t>(data, 12);
+    const uint32_t width = read<uint32_t>(data, 16);
+    const uint32_t depth = (flags & DDSD_DEPTH) ? std::max(read<uint32_t>(data, 24), 1u) : 1u;
+    const uint32_t levels = (flags & DDSD_MIPMAPCOUNT) ? std::max(read<uint32_t>(data, 28), 1u) : 1u;
+    const uint32_t pixelFormatFlags = read<uint32_t>(data, 80);
+    const uint32_t pixelFormatFourCC = read<uint32_t>(data, 84);
+    const uint32_t rgbBitCount = read<uint32_t>(data, 88);
+    const uint32_t redMask = read<uint32_t>(data, 92);
+    const uint32_t caps2 = read<uint32_t>(data, 112);
+
+    bool volume = depth > 1;
+    bool supported = (caps2 & DDSCAPS2_CUBEMAP) == 0;
+
+    if ((pixelFormatFlags & DDPF_FOURCC) && pixelFormatFourCC == fourCC("DX10"))
+    {
+        offset = 148;
+        if (size < offset)
+            return false;
+
+        const uint32_t dxgiFormat = read<uint32_t>(data, 128);
+        const uint32_t resourceDimension = read<uint32_t>(data, 132);
+        const uint32_t miscFlag = read<uint32_t>(data, 136);
+        const uint32_t arraySize = read<uint32_t>(data, 140);
+
+        // arrays store all levels of one layer after another, so levels are not contiguous
+        supported = supported && (miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) == 0 && arraySize <= 1;
+        volume = resourceDimension == DDS_DIMENSION_TEXTURE3D;
+
+        if (supported && !setFormatFromDXGI(dxgiFormat))
+        {
+            std::cerr << "DDS file \"" << m_file.filePath() << "\" has unsupported DXGI format " << dxgiFormat << "." << std::endl;
+            return false;
+        }
+    }
+    else if (pixelFormatFlags & DDPF_FOURCC)
+    {
+        if (pixelFormatFourCC == fourCC("DXT1"))
+            setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8);
+        else if (pixelFormatFourCC == fourCC("DXT3"))
+            setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16);
+        else if (pixelFormatFourCC == fourCC("DXT5"))
+            setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16);
+        else if (pixelFormatFourCC == fourCC("ATI1") || pixelFormatFourCC == fourCC("BC4U"))
+            setCompressedFormat(GL_COMPRESSED_RED_RGTC1, 8);
+        else if (pixelFormatFourCC == fourCC("BC4S"))
+            setCompressedFormat(GL_COMPRESSED_SIGNED_RED_RGTC1, 8);
+        else if (pixelFormatFourCC == fourCC("ATI2") || pixelFormatFourCC == fourCC("BC5U"))
+            setCompressedFormat(GL_COMPRESSED_RG_RGTC2, 16);
+        else if (pixelFormatFourCC == fourCC("BC5S"))
+            setCompressedFormat(GL_COMPRESSED_SIGNED_RG_RGTC2, 16);
+        else
+            supported = false;
+    }
+    else if ((pixelFormatFlags & DDPF_RGB) && rgbBitCount == 32)
+    {
+        setUncompressedFormat(GL_RGBA8, redMask == 0x00ff0000 ? GL_BGRA : GL_RGBA, GL_UNSIGNED_BYTE, 4);
+    }
+    else if ((pixelFormatFlags & DDPF_RGB) && rgbBitCount == 24)
+    {
+        setUncompressedFormat(GL_RGB8, redMask == 0x00ff0000 ? GL_BGR : GL_RGB, GL_UNSIGNED_BYTE, 3);
+    }
+    else
+    {
+        supported = false;
+    }
+
+    if (!supported)
+    {
+        std::cerr << "DDS file \"" << m_file.filePath() << "\" is not a supported 2D or 3D texture." << std::endl;
+        return false;
+    }
+
+    m_target = volume ? GL_TEXTURE_3D : GL_TEXTURE_2D;
+    m_unpackAlignment = 1;
+
+    for (uint32_t i = 0; i < levels; ++i)
+    {
+        Level level;
+        level.level = static_cast<GLint>(i);
+        level.width = mipmapExtent(width, level.level);
+        level.height = mipmapExtent(height, level.level);
+        level.depth = volume ? mipmapExtent(depth, level.level) : 1;
+        level.data = data + offset;
+        level.size = levelSize(level.width, level.height, level.depth);
+
+        if (offset + level.size > size)
+            return false;
+
+        m_levels.push_back(level);
+
+        offset += level.size;
+    }
+
+    return true;
+}
+
+bool TextureContainer::setFormatFromVulkan(const unsigned int vkFormat)
+{
+    switch (vkFormat)
+    {
+    case   9: setUncompressedFormat(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1); return true;
+    case  16: setUncompressedFormat(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2); return true;
+    case  37: setUncompressedFormat(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4); return true;
+    case  43: setUncompressedFormat(GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4); return true;
+    case  44: setUncompressedFormat(GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4); return true;
+    case  50: setUncompressedFormat(GL_SRGB8_ALPHA8, GL_BGRA, GL_UNSIGNED_BYTE, 4); return true;
+    case  97: setUncompressedFormat(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8); return true;
+    case 109: setUncompressedFormat(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16); return true;
+
+    case 131: setCompressedFormat(GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8); return true;
+    case 132: setCompressedFormat(GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, 8); return true;
+    case 133: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8); return true;
+    case 134: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8); return true;
+    case 135: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16); return true;
+    case 136: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 16); return true;
+    case 137: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16); return true;
+    case 138: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16); return true;
+    case 139: setCompressedFormat(GL_COMPRESSED_RED_RGTC1, 8); return true;
+    case 140: setCompressedFormat(GL_COMPRESSED_SIGNED_RED_RGTC1, 8); return true;
+    case 141: setCompressedFormat(GL_COMPRESSED_RG_RGTC2, 16); return true;
+    case 142: setCompressedFormat(GL_COMPRESSED_SIGNED_RG_RGTC2, 16); return true;
+    case 143: setCompressedFormat(GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, 16); return true;
+    case 144: setCompressedFormat(GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, 16); return true;
+    case 145: setCompressedFormat(GL_COMPRESSED_RGBA_BPTC_UNORM, 16); return true;
+    case 146: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 16); return true;
+
+    default:
+        return false;
+    }
+}
+
+bool TextureContainer::setFormatFromDXGI(const unsigned int dxgiFormat)
+{
+    switch (dxgiFormat)
+    {
+    case  2: setUncompressedFormat(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16); return true;
+    case 10: setUncompressedFormat(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8); return true;
+    case 28: setUncompressedFormat(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4); return true;
+    case 29: setUncompressedFormat(GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4); return true;
+    case 49: setUncompressedFormat(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2); return true;
+    case 61: setUncompressedFormat(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1); return true;
+    case 87: setUncompressedFormat(GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, 4); return true;
+    case 91: setUncompressedFormat(GL_SRGB8_ALPHA8, GL_BGRA, GL_UNSIGNED_BYTE, 4); return true;
+
+    case 71: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8); return true;
+    case 72: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8); return true;
+    case 74: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16); return true;
+    case 75: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 16); return true;
+    case 77: setCompressedFormat(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16); return true;
+    case 78: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16); return true;
+    case 80: setCompressedFormat(GL_COMPRESSED_RED_RGTC1, 8); return true;
+    case 81: setCompressedFormat(GL_COMPRESSED_SIGNED_RED_RGTC1, 8); return true;
+    case 83: setCompressedFormat(GL_COMPRESSED_RG_RGTC2, 16); return true;
+    case 84: setCompressedFormat(GL_COMPRESSED_SIGNED_RG_RGTC2, 16); return true;
+    case 95: setCompressedFormat(GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, 16); return true;
+    case 96: setCompressedFormat(GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, 16); return true;
+    case 98: setCompressedFormat(GL_COMPRESSED_RGBA_BPTC_UNORM, 16); return true;
+    case 99: setCompressedFormat(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 16); return true;
+
+    default:
+        return false;
+    }
+}
+
+void TextureContainer::setCompressedFormat(const GLenum internalFormat, const GLint blockSize)
+{
+    m_internalFormat = internalFormat;
+    m_format = GL_NONE;
+    m_type = GL_NONE;
+    m_compressed = true;
+    m_blockSize = blockSize;
+    m_bytesPerPixel = 0;
+}
+
+void TextureContainer::setUncompressedFormat(const GLenum internalFormat, const GLenum format, const GLenum type, const GLint bytesPerPixel)
+{
+    m_internalFormat = internalFormat;
+    m_format = format;
+    m_type = type;
+    m_compressed = false;
+    m_blockSize = 0;
+    m_bytesPerPixel = bytesPerPixel;
+}
+
+GLsizei TextureContainer::levelSize(const GLsizei width, const GLsizei height, const GLsizei depth) const
+{
+    if (m_compressed)
+        return ((width + 3) / 4) * ((height + 3) / 4) * m_blockSize * depth;
+
+    return width * height * depth * m_bytesPerPixel;
+}
@@ -0,0 +1,91 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include "MappedFile.h"
+
+namespace globjects
+{
+    class Texture;
+}
+
+
+/** Memory mapped KTX1, KTX2 (without supercompression) or DDS texture container.
+    Supported are 2D, 2D array and 3D textures with arbitrary mipmap chains.
+    The levels reference the mapped file, so upload() passes them to OpenGL
+    without any intermediate copy. Compressed levels are uploaded using
+    compressedImage2D/3D, uncompressed ones using storage2D/3D and subImage2D/3D.
+*/
+class TextureContainer
+{
+public:
+    struct Level
+    {
+        gl::GLint level;
+        gl::GLsizei width;
+        gl::GLsizei height;
+        gl::GLsizei depth;
+
+        const char * data;
+        gl::GLsizei size;
+    };
+
+public:
+    TextureContainer(const std::string & filePath);
+    virtual ~TextureContainer();
+
+    bool isValid() const;
+
+    gl::GLenum target() const;
+    gl::GLenum internalFormat() const;
+    gl::GLenum format() const;
+    gl::GLenum type() const;
+    bool isCompressed() const;
+
+    const std::vector<Level> & levels() const;
+
+    /** Creates a texture matching target() and uploads all levels.
+        Returns nullptr if the container is not valid.
+    */
+    globjects::Texture * createTexture() const;
+
+    /** Uploads all levels to texture, which has to match target().
+    */
+    void upload(globjects::Texture * texture) const;
+
+    // levels point into the mapped file
+    TextureContainer(const TextureContainer &) = delete;
+    TextureContainer & operator=(const TextureContainer &) = delete;
+
+protected:
+    bool readKTX1();
+    bool readKTX2();
+    bool readDDS();
+
+    bool setFormatFromVulkan(unsigned int vkFormat);
+    bool setFormatFromDXGI(unsigned int dxgiFormat);
+    void setCompressedFormat(gl::GLenum internalFormat, gl::GLint blockSize);
+    void setUncompressedFormat(gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type, gl::GLint bytesPerPixel);
+
+    gl::GLsizei levelSize(gl::GLsizei width, gl::GLsizei height, gl::GLsizei depth) const;
+
+protected:
+    MappedFile m_file;
+
+    gl::GLenum m_target;
+    gl::GLenum m_internalFormat;
+    gl::GLenum m_format;
+    gl::GLenum m_type;
+    bool m_compressed;
+    gl::GLint m_blockSize;
+    gl::GLint m_bytesPerPixel;
+    gl::GLint m_unpackAlignment;
+
+    std::vector<Level> m_levels;
+
+    bool m_valid;
+};
@@ -13,6 +13,7 @@
 #include <common/events.h>
 
 #include "RawFile.h"
+#include "TextureContainer.h"
 
 
 using namespace gl;
@@ -32,6 +33,14 @@ public:
 
     void createAndSetupTexture()
     {
+        // prefer the container, its levels are uploaded directly from the mapped file
+        TextureContainer container("data/glraw-texture/dog-on-pillow.dds");
+        if (container.isValid())
+        {
+            m_texture = container.createTexture();
+            return;
+        }
+
         RawFile raw("data/glraw-texture/dog-on-pillow.raw");
         if (!raw.isValid())
             return;
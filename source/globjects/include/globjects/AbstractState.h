@@ -10,6 +10,7 @@
 namespace globjects
 {
 
+class StateBlock;
 class StateSetting;
 
 class GLOBJECTS_API AbstractState
@@ -38,6 +39,9 @@ public:
     void cullFace(gl::GLenum mode);
     void depthFunc(gl::GLenum func);
     void depthMask(gl::GLboolean flag);
+    /** \brief Sets the depth range in single precision, as StateBlock stores it.
+        The rounding is below the resolution of fixed point depth buffers of up to 24 bits, floating point depth buffers may resolve finer.
+    */
     void depthRange(gl::GLdouble nearVal, gl::GLdouble farVal);
     void depthRange(gl::GLfloat nearVal, gl::GLfloat farVal);
     void depthRange(const std::array<gl::GLfloat, 2> & range);
@@ -62,6 +66,11 @@ public:
 
     virtual void add(StateSetting * setting) = 0;
 
+    /** \brief Sets the fields and capabilities set in values; used by the standard setters.
+        By default, each capability is set with setEnabled() and each field is added as a StateSetting.
+    */
+    virtual void add(const StateBlock & values);
+
     template <typename... Arguments>
     void set(void (*function)(Arguments...), Arguments... arguments);
 };
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+#include <globjects/TextureHandle.h>
+
+namespace globjects
+{
+
+class Texture;
+
+
+/** \brief Keeps bindless texture handles resident only while they are in use.
+
+    Every texture that is used in a frame has to be passed to touch(), which
+    makes its handle resident if necessary and returns it. nextFrame() marks
+    the end of a frame: textures that were not touched for maxUnusedFrames()
+    frames are made non-resident again. If a memory budget is set, the least
+    recently used textures are made non-resident as soon as the estimated size
+    of all resident textures exceeds the budget. Textures touched within the
+    current frame are never evicted.
+
+    The manager keeps a reference to each resident texture, so a texture is
+    not deleted while its handle is resident.
+
+    \code{.cpp}
+
+        BindlessResidencyManager * residency = new BindlessResidencyManager(8);
+        residency->setMemoryBudget(512 * 1024 * 1024);
+
+        // per draw
+        program->setUniform("diffuse", residency->touch(material->texture()));
+
+        // per frame
+        residency->nextFrame();
+
+    \endcode
+
+    \see Texture::makeResident()
+    \see http://www.opengl.org/registry/specs/ARB/bindless_texture.txt
+ */
+class GLOBJECTS_API BindlessResidencyManager : public Referenced
+{
+public:
+    struct FrameStatistics
+    {
+        FrameStatistics();
+
+        unsigned int madeResident;
+        unsigned int madeNonResident;
+    };
+
+public:
+    BindlessResidencyManager(unsigned int maxUnusedFrames = 3);
+
+    unsigned int maxUnusedFrames() const;
+    void setMaxUnusedFrames(unsigned int frames);
+
+    /** \brief Sets the estimated size in bytes all resident textures may occupy.
+        A budget of 0 (default) disables budget based eviction.
+    */
+    gl::GLint64 memoryBudget() const;
+    void setMemoryBudget(gl::GLint64 bytes);
+
+    /** \brief Marks texture as used in the current frame and makes its handle resident if required.
+        The size of the texture is estimated from its level 0 parameters once.
+        \return the resident handle of texture
+    */
+    TextureHandle touch(Texture * texture);
+
+    /** \brief Same as touch(Texture *), but uses sizeInBytes instead of querying the texture's size.
+    */
+    TextureHandle touch(Texture * texture, gl::GLint64 sizeInBytes);
+
+    /** \brief Makes the handle of texture non-resident immediately and stops tracking it.
+    */
+    void release(Texture * texture);
+
+    /** \brief Makes all tracked handles non-resident.
+    */
+    void releaseAll();
+
+    /** \brief Evicts unused textures and starts a new frame.
+        The statistics of the finished frame are available through lastFrameStatistics().
+    */
+    void nextFrame();
+
+    bool isResident(const Texture * texture) const;
+
+    std::size_t residentCount() const;
+    gl::GLint64 residentMemory() const;
+
+    const FrameStatistics & currentFrameStatistics() const;
+    const FrameStatistics & lastFrameStatistics() const;
+
+protected:
+    virtual ~BindlessResidencyManager();
+
+    struct Entry
+    {
+        ref_ptr<Texture> texture;
+        TextureHandle handle;
+        gl::GLint64 size;
+        unsigned long long lastUsed;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void makeNonResident(EntryList::iterator entry);
+    void evictOverBudget();
+
+    static gl::GLint64 estimateSize(const Texture * texture);
+
+protected:
+    unsigned int m_maxUnusedFrames;
+    gl::GLint64 m_memoryBudget;
+    gl::GLint64 m_residentMemory;
+    unsigned long long m_frame;
+
+    EntryList m_entries; // most recently used first
+    std::unordered_map<const Texture *, EntryList::iterator> m_lookup;
+
+    FrameStatistics m_currentFrame;
+    FrameStatistics m_lastFrame;
+};
+
+} // namespace globjects
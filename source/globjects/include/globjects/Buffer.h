@@ -247,6 +247,11 @@ public:
 
     virtual gl::GLenum objectType() const override;
 
+    /** \brief Returns a number identifying this object over the process lifetime.
+        Unlike id() and the object's address, it is never reused after the buffer was released.
+    */
+    unsigned int serial() const;
+
 protected:
     /** \brief Creates a buffer with an external id.
         \param id an external OpenGL buffer id
@@ -257,6 +262,9 @@ protected:
         \see https://www.opengl.org/sdk/docs/man4/xhtml/gl::glDeleteBuffers.xml
     */
     virtual ~Buffer();
+
+protected:
+    const unsigned int m_serial;
 };
 
 } // namespace globjects
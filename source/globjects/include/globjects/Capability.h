@@ -25,6 +25,10 @@ public:
     void disable(int index);
     bool isEnabled(int index) const;
 
+    /** \brief Returns the per index states; empty if the capability is set as a whole.
+    */
+    const std::map<int, bool> & indexEnabled() const;
+
     void apply();
 
 protected:
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Buffer;
+class VertexArray;
+
+
+/** \brief Layout of a single command in GL_DRAW_INDIRECT_BUFFER for glMultiDrawArraysIndirect.
+*/
+struct DrawArraysIndirectCommand
+{
+    gl::GLuint count;
+    gl::GLuint instanceCount;
+    gl::GLuint first;
+    gl::GLuint baseInstance;
+};
+
+/** \brief Layout of a single command in GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect.
+*/
+struct DrawElementsIndirectCommand
+{
+    gl::GLuint count;
+    gl::GLuint instanceCount;
+    gl::GLuint firstIndex;
+    gl::GLint baseVertex;
+    gl::GLuint baseInstance;
+};
+
+
+/** \brief Collects indirect draw commands and per-draw records and submits them with a single multi draw call.
+
+    Commands are appended into a CPU side array and uploaded into a
+    GL_DRAW_INDIRECT_BUFFER in one go on the next draw (or upload()). All
+    commands of a buffer share the primitive mode and, for indexed draws, the
+    index type; an index type of GL_NONE selects non-indexed commands.
+
+    Optionally, each command is paired with a record of recordSize bytes,
+    e.g., a model matrix and material index. The records are uploaded into a
+    shader storage buffer in command order, so shaders can fetch the record of
+    the current draw with gl_DrawIDARB (GL_ARB_shader_draw_parameters). The
+    record size has to match the array stride of the record struct in the
+    std430 layout.
+
+    The draw count may be sourced from a GL_PARAMETER_BUFFER, e.g., written
+    by a culling compute shader (GL_ARB_indirect_parameters).
+
+    \code{.cpp}
+
+        DrawCommandBuffer * commands = new DrawCommandBuffer(gl::GL_TRIANGLES, gl::GL_UNSIGNED_INT, sizeof(glm::mat4));
+
+        for (const Mesh & mesh : meshes)
+            commands->add(DrawElementsIndirectCommand{ mesh.indexCount, 1, mesh.firstIndex, mesh.baseVertex, 0 }, &mesh.model);
+
+        // layout (std430, binding = 0) buffer Records { mat4 models[]; };
+        // ... models[gl_DrawIDARB] ...
+        commands->bindRecords(0);
+        commands->draw(vao);
+
+    \endcode
+
+    \see http://www.opengl.org/registry/specs/ARB/indirect_parameters.txt
+    \see http://www.opengl.org/registry/specs/ARB/shader_draw_parameters.txt
+ */
+class GLOBJECTS_API DrawCommandBuffer : public Referenced
+{
+public:
+    DrawCommandBuffer(gl::GLenum mode, gl::GLenum indexType, gl::GLsizeiptr recordSize = 0);
+
+    gl::GLenum mode() const;
+    gl::GLenum indexType() const;
+    gl::GLsizeiptr recordSize() const;
+
+    /** \brief Appends a command and returns its index, which is its gl_DrawIDARB if the whole buffer is drawn.
+    */
+    unsigned int add(const DrawArraysIndirectCommand & command, const void * record = nullptr);
+    unsigned int add(const DrawElementsIndirectCommand & command, const void * record = nullptr);
+
+    void setRecord(unsigned int drawID, const void * record);
+
+    unsigned int size() const;
+    void clear();
+
+    /** \brief Uploads commands and records, if changed since the last upload.
+    */
+    void upload();
+
+    Buffer * commandBuffer() const;
+    Buffer * recordBuffer() const;
+
+    /** \brief Binds the records to the indexed GL_SHADER_STORAGE_BUFFER binding point.
+    */
+    void bindRecords(gl::GLuint index);
+
+    void draw(const VertexArray * vao);
+
+    /** \brief Draws the first n commands, with n read from parameterBuffer at offset as GLsizei.
+    */
+    void draw(const VertexArray * vao, Buffer * parameterBuffer, gl::GLintptr offset = 0);
+
+protected:
+    virtual ~DrawCommandBuffer();
+
+    unsigned int append(const void * command, gl::GLsizeiptr commandSize, const void * record);
+
+    static void uploadTo(Buffer * buffer, gl::GLsizeiptr & capacity, const std::vector<char> & data);
+
+protected:
+    gl::GLenum m_mode;
+    gl::GLenum m_indexType;
+    gl::GLsizeiptr m_commandSize;
+    gl::GLsizeiptr m_recordSize;
+
+    std::vector<char> m_commands;
+    std::vector<char> m_records;
+    bool m_dirty;
+
+    ref_ptr<Buffer> m_commandBuffer;
+    ref_ptr<Buffer> m_recordBuffer;
+    gl::GLsizeiptr m_commandCapacity;
+    gl::GLsizeiptr m_recordCapacity;
+};
+
+} // namespace globjects
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Framebuffer;
+class RenderTargetPool;
+class Texture;
+
+
+/** \brief Declarative description of the render passes of a frame.
+
+    Passes are added with a setup function, which declares the textures the
+    pass creates, reads, and writes, and an execute function, which issues
+    the pass's draw calls. compile() then
+
+    - culls passes that contribute neither to an output (markOutput(), imported
+      textures) nor have side effects,
+    - computes the lifetime of each transient texture, i.e., the range of
+      passes using it,
+    - assigns transient textures with equal description and non-overlapping
+      lifetimes to the same physical texture, and
+    - determines the memory barriers required between passes writing
+      textures as images and passes consuming them.
+
+    execute() allocates the physical textures from a RenderTargetPool, binds a
+    framebuffer with the attachments written by each pass, issues the barriers,
+    and invalidates transient attachments after their last use.
+
+    \code{.cpp}
+
+        FrameGraph * graph = new FrameGraph();
+
+        FrameGraph::Handle color = graph->import("backbuffer", colorTexture);
+        FrameGraph::Handle depth = 0;
+
+        graph->addPass("depth prepass", [&](FrameGraph::PassBuilder & builder)
+        {
+            depth = builder.create("depth", FrameGraph::TextureDescription(gl::GL_DEPTH_COMPONENT24, viewport));
+            builder.write(depth, gl::GL_DEPTH_ATTACHMENT);
+        },
+        [&](const FrameGraph::PassResources &)
+        {
+            scene.drawDepth();
+        });
+
+        graph->addPass("shading", [&](FrameGraph::PassBuilder & builder)
+        {
+            builder.read(depth);
+            builder.write(color, gl::GL_COLOR_ATTACHMENT0);
+        },
+        [&](const FrameGraph::PassResources & resources)
+        {
+            resources.texture(depth)->bindActive(gl::GL_TEXTURE0);
+            scene.draw();
+        });
+
+        graph->compile();
+        graph->execute();
+
+        info() << graph->dump();
+
+    \endcode
+ */
+class GLOBJECTS_API FrameGraph : public Referenced
+{
+public:
+    using Handle = unsigned int;
+
+    enum class Access
+    {
+        Sampled
+    ,   Image
+    ,   Attachment
+    };
+
+    struct GLOBJECTS_API TextureDescription
+    {
+        TextureDescription();
+        TextureDescription(gl::GLenum internalFormat, const glm::ivec2 & size);
+        TextureDescription(gl::GLenum target, gl::GLenum internalFormat, const glm::ivec3 & size, gl::GLsizei samples = 0);
+
+        bool operator==(const TextureDescription & other) const;
+
+        gl::GLenum target;
+        gl::GLenum internalFormat;
+        glm::ivec3 size;
+        gl::GLsizei samples;
+    };
+
+    class GLOBJECTS_API PassBuilder
+    {
+        friend class FrameGraph;
+
+    public:
+        /** \brief Declares a transient texture, which lives from this pass to its last reader.
+        */
+        Handle create(const std::string & name, const TextureDescription & description);
+
+        void read(Handle resource, Access access = Access::Sampled);
+        void write(Handle resource, gl::GLenum attachment);
+        void writeImage(Handle resource);
+
+        /** \brief Prevents the pass from being culled.
+        */
+        void setSideEffect();
+
+    protected:
+        PassBuilder(FrameGraph & graph, Handle pass);
+
+        // Note: this is intentionally not implemented - but fixes MSVC12 C4512 warning
+        PassBuilder & operator=(const PassBuilder &);
+
+    protected:
+        FrameGraph & m_graph;
+        Handle m_pass;
+    };
+
+    class GLOBJECTS_API PassResources
+    {
+        friend class FrameGraph;
+
+    public:
+        Texture * texture(Handle resource) const;
+
+        /** \brief Returns the framebuffer bound for the pass or nullptr if the pass does not write attachments.
+        */
+        Framebuffer * framebuffer() const;
+
+    protected:
+        PassResources(const FrameGraph & graph, Framebuffer * framebuffer);
+
+        // Note: this is intentionally not implemented - but fixes MSVC12 C4512 warning
+        PassResources & operator=(const PassResources &);
+
+    protected:
+        const FrameGraph & m_graph;
+        Framebuffer * m_framebuffer;
+    };
+
+    using Setup = std::function<void(PassBuilder &)>;
+    using Execute = std::function<void(const PassResources &)>;
+
+public:
+    FrameGraph();
+
+    /** \brief Registers an externally owned texture; it is neither aliased nor invalidated and counts as output.
+    */
+    Handle import(const std::string & name, Texture * texture);
+    void markOutput(Handle resource);
+
+    void addPass(const std::string & name, const Setup & setup, const Execute & execute);
+
+    void compile();
+    void execute();
+
+    /** \brief Removes all passes and resources; physical textures and framebuffers are kept for the next frame.
+    */
+    void reset();
+
+    std::string dump() const;
+
+protected:
+    virtual ~FrameGraph();
+
+    struct Usage
+    {
+        Handle resource;
+        Access access;
+        gl::GLenum attachment;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        Execute execute;
+
+        std::vector<Usage> reads;
+        std::vector<Usage> writes;
+        bool sideEffect;
+
+        unsigned int refCount;
+        bool culled;
+
+        bool barrier;
+        gl::MemoryBarrierMask barriers;
+    };
+
+    struct Resource
+    {
+        std::string name;
+        TextureDescription description;
+
+        ref_ptr<Texture> imported;
+        bool output;
+
+        std::vector<Handle> writers;
+        unsigned int refCount;
+
+        bool used;
+        Handle firstUse;
+        Handle lastUse;
+        int physical;
+    };
+
+    struct FramebufferEntry
+    {
+        ref_ptr<Framebuffer> framebuffer;
+        unsigned long long lastUsed;
+    };
+
+    using FramebufferKey = std::vector<std::pair<gl::GLenum, const Texture *>>;
+
+    void cull();
+    void computeLifetimes();
+    void assignPhysicalTextures();
+    void computeBarriers();
+
+    Framebuffer * obtainFramebuffer(const Pass & pass);
+
+protected:
+    std::vector<Pass> m_passes;
+    std::vector<Resource> m_resources;
+
+    std::vector<TextureDescription> m_physicalDescriptions;
+    std::vector<Texture *> m_physicalTextures;
+
+    bool m_compiled;
+    unsigned long long m_frame;
+
+    ref_ptr<RenderTargetPool> m_pool;
+    std::map<FramebufferKey, FramebufferEntry> m_framebuffers;
+};
+
+} // namespace globjects
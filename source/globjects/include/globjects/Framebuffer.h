@@ -72,6 +72,10 @@ public:
     static void unbind(gl::GLenum target);
 
     void setParameter(gl::GLenum pname, gl::GLint param);
+
+    /** \brief Returns an attachment parameter, answered from a CPU side mirror for attachments made through this object.
+        Parameters not derivable from the attachment (e.g., component sizes) are queried once per attachment and cached.
+    */
     gl::GLint getAttachmentParameter(gl::GLenum attachment, gl::GLenum pname) const;
 
     void attachTexture(gl::GLenum attachment, Texture * texture, gl::GLint level = 0);
@@ -85,6 +89,18 @@ public:
     void setDrawBuffers(gl::GLsizei n, const gl::GLenum * modes) const;
     void setDrawBuffers(const std::vector<gl::GLenum> & modes) const;
 
+    /** \brief Discards the contents of the given attachments, which may save bandwidth.
+        Does nothing without OpenGL 4.3 or ARB_invalidate_subdata.
+        \see https://www.opengl.org/sdk/docs/man/html/glInvalidateFramebuffer.xhtml
+    */
+    void invalidate(const std::vector<gl::GLenum> & attachments) const;
+    void invalidate(const std::vector<gl::GLenum> & attachments, const std::array<gl::GLint, 4> & rect) const;
+
+    /** \brief Discards the contents of all attachments marked as transient (FramebufferAttachment::setTransient()).
+        Call it at the end of the pass, i.e., after the last read from this framebuffer.
+    */
+    void invalidateTransientAttachments() const;
+
     void clear(gl::ClearBufferMask mask);
 
     void clearBufferiv(gl::GLenum buffer, gl::GLint drawBuffer, const gl::GLint * value);
@@ -111,10 +127,24 @@ public:
     std::vector<unsigned char> readPixelsToByteArray(gl::GLenum readBuffer, const std::array<gl::GLint, 4> & rect, gl::GLenum format, gl::GLenum type) const;
     void readPixelsToBuffer(const std::array<gl::GLint, 4> & rect, gl::GLenum format, gl::GLenum type, Buffer * pbo) const;
 
+    /** \brief Number of times this framebuffer was bound for drawing or its attachments changed.
+        Comparing counts tells whether the contents may have changed in between, e.g., to skip redundant resolves.
+        Binds made by globjects only to configure or query the framebuffer are not counted.
+    */
+    unsigned long long writeCount() const;
+
+    /** \brief Returns the completeness status, which is queried only after the configuration changed.
+        \see resetCachedState
+    */
     gl::GLenum checkStatus() const;
     std::string statusString() const;
     void printStatus(bool onlyErrors = false) const;
 
+    /** \brief Discards the cached status and attachment parameters.
+        Required if attached textures or renderbuffers are respecified or the framebuffer is modified outside of globjects.
+    */
+    void resetCachedState() const;
+
     FramebufferAttachment * getAttachment(gl::GLenum attachment);
     std::vector<FramebufferAttachment*> attachments();
 
@@ -128,12 +158,18 @@ protected:
     virtual ~Framebuffer();
 
     void addAttachment(FramebufferAttachment * attachment);
+    void attachmentChanged(gl::GLenum attachment);
 
     static void blit(gl::GLint srcX0, gl::GLint srcY0, gl::GLint srcX1, gl::GLint srcY1, gl::GLint destX0, gl::GLint destY0, gl::GLint destX1, gl::GLint destY1, gl::ClearBufferMask mask, gl::GLenum filter);
     static void blit(const std::array<gl::GLint, 4> & srcRect, const std::array<gl::GLint, 4> & destRect, gl::ClearBufferMask mask, gl::GLenum filter);
 
 protected:
 	std::map<gl::GLenum, ref_ptr<FramebufferAttachment>> m_attachments;
+    mutable unsigned long long m_writeCount;
+
+    mutable bool m_statusValid;
+    mutable gl::GLenum m_status;
+    mutable std::map<gl::GLenum, std::map<gl::GLenum, gl::GLint>> m_attachmentParameters;
 };
 
 } // namespace globjects
@@ -42,9 +42,17 @@ public:
 
 	std::string attachmentString() const;
 
+    /** \brief Marks the attachment's contents as only needed while rendering into the framebuffer, e.g., a depth buffer used within a single pass.
+        Transient attachments are invalidated at the end of a pass by Framebuffer::invalidateTransientAttachments().
+        \see Framebuffer::invalidateTransientAttachments
+    */
+    void setTransient(bool transient);
+    bool isTransient() const;
+
 protected:
     Framebuffer * m_fbo; // TODO: weak pointer?
 	gl::GLenum m_attachment;
+    bool m_transient;
 };
 
 } // namespace globjects
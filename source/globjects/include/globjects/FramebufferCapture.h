@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Buffer;
+class Framebuffer;
+class Sync;
+
+
+/** \brief Pipelined read back of framebuffer contents through a ring of pixel pack buffers.
+
+    Each capture() reads the framebuffer into the next buffer of the ring
+    using Framebuffer::readPixelsToBuffer() and fences it. The capture issued
+    bufferCount() - 1 calls earlier is then mapped and handed to the callback,
+    so the GPU has bufferCount() - 1 frames to finish the transfer and the
+    read back does not stall the pipeline. The mapped pointer is only valid
+    within the callback.
+
+    The size of a capture is computed with the pack alignment current when
+    the rect size, format or type change, not on every capture, as querying
+    it synchronizes with the driver. Change the pack alignment only along
+    with them.
+
+    \code{.cpp}
+
+        FramebufferCapture * capture = new FramebufferCapture(3);
+        capture->setCallback([](const FramebufferCapture::Frame & frame)
+        {
+            encode(frame.data, frame.size);
+        });
+
+        // per frame
+        capture->capture(fbo, GL_COLOR_ATTACHMENT0, viewport, GL_RGBA, GL_UNSIGNED_BYTE);
+
+        // at shutdown
+        capture->flush();
+
+    \endcode
+
+    \see Framebuffer::readPixelsToBuffer
+ */
+class GLOBJECTS_API FramebufferCapture : public Referenced
+{
+public:
+    struct Frame
+    {
+        unsigned long long index;
+
+        std::array<gl::GLint, 4> rect;
+        gl::GLenum format;
+        gl::GLenum type;
+
+        const void * data;
+        gl::GLsizeiptr size;
+    };
+
+    using Callback = std::function<void(const Frame &)>;
+
+public:
+    FramebufferCapture(unsigned int bufferCount = 3);
+
+    unsigned int bufferCount() const;
+
+    void setCallback(const Callback & callback);
+
+    /** \brief Reads rect of the current read buffer of fbo and delivers the capture issued bufferCount() - 1 calls earlier.
+    */
+    void capture(const Framebuffer * fbo, const std::array<gl::GLint, 4> & rect, gl::GLenum format, gl::GLenum type);
+    void capture(const Framebuffer * fbo, gl::GLenum readBuffer, const std::array<gl::GLint, 4> & rect, gl::GLenum format, gl::GLenum type);
+
+    /** \brief Delivers all outstanding captures, blocking until they are available.
+    */
+    void flush();
+
+    unsigned long long capturedFrames() const;
+    unsigned long long deliveredFrames() const;
+
+protected:
+    virtual ~FramebufferCapture();
+
+    struct Slot
+    {
+        ref_ptr<Buffer> buffer;
+        gl::GLsizeiptr capacity;
+
+        ref_ptr<Sync> fence;
+        Frame frame;
+    };
+
+    void deliver(Slot & slot);
+
+    gl::GLsizeiptr sizeInBytes(gl::GLsizei width, gl::GLsizei height, gl::GLenum format, gl::GLenum type);
+
+protected:
+    std::vector<Slot> m_slots;
+    unsigned int m_next;
+
+    /** Size of the most recent capture and the rect size, format and type it was computed for */
+    gl::GLsizeiptr m_size;
+    std::array<gl::GLuint, 4> m_sizeKey;
+
+    Callback m_callback;
+
+    unsigned long long m_capturedFrames;
+    unsigned long long m_deliveredFrames;
+};
+
+} // namespace globjects
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <glbinding/ContextHandle.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Sync;
+
+
+/** \brief Runs OpenGL work, e.g., buffer and texture uploads or shader compiles, on worker threads with contexts shared with the main context.
+
+    globjects does not create contexts itself: createContext is called on each
+    worker thread to create a context shared with the main context and make it
+    current, destroyContext releases it on shutdown. The pool registers the
+    worker contexts as shared with the context current at construction.
+    The constructor waits until each worker created its context or failed to,
+    so createContext must not wait for the constructing thread. Workers whose
+    context creation failed do not run; if none runs, tasks are rejected.
+
+    Each finished task is fenced with a Sync. processCompleted(), called on the
+    main thread once per frame, hands finished tasks over: it inserts a server
+    side wait for each fence and runs the completion. The main thread never
+    blocks on loading.
+
+    Objects created by a task must not be used by the main context before its
+    completion ran. Completions that did not run before the pool is released
+    are dropped.
+
+    \code{.cpp}
+
+        GLWorkerPool * pool = new GLWorkerPool(2,
+            [](unsigned int worker) { return makeSharedContextCurrent(worker); },
+            [](unsigned int worker) { destroySharedContext(worker); });
+
+        pool->load<Texture>([]() { return loadTexture("data/diffuse.ktx"); },
+            [this](Texture * texture) { m_diffuse = texture; });
+
+        // per frame
+        pool->processCompleted();
+
+    \endcode
+
+    \see Sync
+ */
+class GLOBJECTS_API GLWorkerPool : public Referenced
+{
+public:
+    /** \brief Creates a context shared with the main context and makes it current on the calling worker thread.
+        \return false if the context could not be created
+    */
+    using CreateContext = std::function<bool(unsigned int worker)>;
+    using DestroyContext = std::function<void(unsigned int worker)>;
+
+    using Task = std::function<void()>;
+    using Completion = std::function<void()>;
+
+public:
+    GLWorkerPool(unsigned int workerCount, const CreateContext & createContext, const DestroyContext & destroyContext);
+
+    unsigned int workerCount() const;
+
+    /** \brief Returns the number of workers that created their context and run tasks.
+    */
+    unsigned int runningWorkers() const;
+
+    /** \brief Queues a task to run on a worker; its completion runs on the main thread within processCompleted().
+        \return false if the task was rejected, as no worker is running
+    */
+    bool submit(const Task & task, const Completion & completion = Completion());
+
+    /** \brief Queues a task creating an object on a worker and hands the object to the completion on the main thread.
+        The object is referenced until the completion returned.
+        \return false if the task was rejected, as no worker is running
+    */
+    template <typename T>
+    bool load(const std::function<T *()> & task, const std::function<void(T *)> & completion);
+
+    /** \brief Waits server side for all finished tasks and runs their completions. Call on the main thread.
+        \return number of completed tasks
+    */
+    unsigned int processCompleted();
+
+    /** \brief Returns the number of submitted tasks whose completion did not run yet.
+    */
+    unsigned int pending() const;
+
+protected:
+    virtual ~GLWorkerPool();
+
+    struct Job
+    {
+        Task task;
+        Completion completion;
+    };
+
+    struct Finished
+    {
+        ref_ptr<Sync> sync;
+        Completion completion;
+    };
+
+    void run(unsigned int worker);
+
+protected:
+    glbinding::ContextHandle m_mainContext;
+
+    CreateContext m_createContext;
+    DestroyContext m_destroyContext;
+
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_started;
+
+    std::deque<Job> m_jobs;
+    std::vector<Finished> m_finished;
+    unsigned int m_pending;
+    bool m_stop;
+
+    // workers that finished context creation, successfully or not, and those that succeeded
+    unsigned int m_startedWorkers;
+    unsigned int m_runningWorkers;
+};
+
+} // namespace globjects
+
+#include <globjects/GLWorkerPool.hpp>
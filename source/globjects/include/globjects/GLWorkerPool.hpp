@@ -0,0 +1,27 @@
+#pragma once
+
+#include <globjects/GLWorkerPool.h>
+
+#include <memory>
+
+namespace globjects
+{
+
+template <typename T>
+bool GLWorkerPool::load(const std::function<T *()> & task, const std::function<void(T *)> & completion)
+{
+    // the task is released on the worker before the completion runs, so the object is released on the main thread
+    std::shared_ptr<ref_ptr<T>> object(new ref_ptr<T>());
+
+    return submit([task, object]()
+    {
+        *object = task();
+    },
+    [completion, object]()
+    {
+        if (completion)
+            completion(object->get());
+    });
+}
+
+} // namespace globjects
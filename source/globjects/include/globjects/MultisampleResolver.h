@@ -0,0 +1,110 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Framebuffer;
+class FramebufferAttachment;
+class Texture;
+
+
+/** \brief Resolves the attachments of a multisampled framebuffer into single sampled textures.
+
+    The resolve targets are created on first use, matching the internal format
+    and size of the source attachments, and are reused as long as the source
+    attachments stay the same. Each resolve blits all requested attachments
+    with one glBlitFramebuffer per color attachment; depth (and stencil) are
+    resolved along with the first color attachment.
+
+    Attachments are skipped if the source framebuffer was neither bound for
+    drawing nor reconfigured since their last resolve (Framebuffer::writeCount()).
+    If the source is rendered to without binding it through globjects, call
+    invalidate() to force the next resolve.
+
+    Resolving does not discard the source's transient attachments, as the
+    source may still be rendered to; call
+    Framebuffer::invalidateTransientAttachments() at the end of the pass.
+
+    \code{.cpp}
+
+        MultisampleResolver * resolver = new MultisampleResolver(msaaFbo);
+
+        // per frame, after rendering into msaaFbo
+        resolver->resolve(true);
+        msaaFbo->invalidateTransientAttachments();
+        resolver->texture(gl::GL_COLOR_ATTACHMENT0)->bindActive(gl::GL_TEXTURE0);
+
+    \endcode
+
+    \see Framebuffer::blit
+ */
+class GLOBJECTS_API MultisampleResolver : public Referenced
+{
+public:
+    MultisampleResolver(Framebuffer * source);
+
+    Framebuffer * source() const;
+
+    /** \brief Returns the single sampled framebuffer holding the resolve targets.
+    */
+    Framebuffer * target() const;
+
+    /** \brief Returns the resolve target of attachment or nullptr if it was not resolved yet.
+    */
+    Texture * texture(gl::GLenum attachment) const;
+
+    /** \brief Resolves all color attachments of the source and, if requested, its depth and stencil attachments.
+    */
+    void resolve(bool depth = false);
+    void resolve(const std::vector<gl::GLenum> & attachments);
+
+    /** \brief Forces all attachments to be resolved on the next resolve.
+    */
+    void invalidate();
+
+    unsigned long long resolvedCount() const;
+    unsigned long long skippedCount() const;
+
+protected:
+    virtual ~MultisampleResolver();
+
+    struct Target
+    {
+        Target();
+
+        ref_ptr<FramebufferAttachment> source;
+        ref_ptr<Texture> texture;
+
+        gl::GLenum internalFormat;
+        glm::ivec2 size;
+
+        unsigned long long writeCount;
+        bool valid;
+    };
+
+    FramebufferAttachment * sourceAttachment(gl::GLenum attachment) const;
+    void updateTarget(gl::GLenum attachment, Target & target, FramebufferAttachment * source);
+
+protected:
+    ref_ptr<Framebuffer> m_source;
+    ref_ptr<Framebuffer> m_target;
+
+    std::map<gl::GLenum, Target> m_targets;
+
+    unsigned long long m_resolvedCount;
+    unsigned long long m_skippedCount;
+};
+
+} // namespace globjects
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <glbinding/gl/types.h>
@@ -12,6 +13,7 @@ namespace globjects
 {
 
 class ObjectVisitor;
+class ObjectRegistry;
 class IDResource;
 
 /** \brief Superclass of all wrapped OpenGL objects.
@@ -54,8 +56,14 @@ protected:
     Object(IDResource * resource);
     virtual ~Object();
 
+    /** \brief Returns whether a context sharing the object is current on the calling thread.
+        If not, e.g., on release from a thread without context, the deletion is deferred to processDeletionQueue().
+    */
+    bool isContextCurrent() const;
+
 protected:
     IDResource * m_resource;
+    std::shared_ptr<ObjectRegistry> m_registry;
 
     mutable void * m_objectLabelState;
 };
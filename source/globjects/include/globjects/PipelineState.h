@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+#include <globjects/StateBlock.h>
+
+namespace globjects
+{
+
+class Framebuffer;
+class Program;
+class State;
+class VertexArray;
+
+
+/** \brief Immutable bundle of program, vertex array, framebuffer and standard pipeline state.
+
+    All parts are fixed at construction, where the hash is computed once.
+    Switching from another pipeline state via apply(from) only issues the
+    parts that differ. Values the predecessor sets and this pipeline state
+    leaves unset are reset to StateBlock::defaults(), so a pipeline state
+    behaves the same regardless of the one applied before. The differences
+    to the most recently used
+    predecessors are computed once and cached, so frequent pairs, e.g.,
+    alternating opaque and transparent passes, switch with a short list of
+    precomputed calls.
+
+    switchCost() estimates the cost of such a switch with fixed weights,
+    ordered framebuffer, program, vertex array and state values, which a
+    render queue can use to order its items.
+
+    Framebuffer or vertex array may be nullptr to leave the respective
+    binding untouched.
+
+    \code{.cpp}
+
+        StateBlock blending;
+        blending.setEnabled(gl::GL_BLEND, true);
+        blending.blendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+
+        PipelineState * opaque = new PipelineState(program, vao, StateBlock());
+        PipelineState * transparent = new PipelineState(program, vao, blending);
+
+        opaque->apply();
+        // ...
+        transparent->apply(opaque); // only blend enable and blend func
+        // ...
+        opaque->apply(transparent); // blend disable and default blend func
+
+    \endcode
+
+    \see StateBlock
+ */
+class GLOBJECTS_API PipelineState : public Referenced
+{
+public:
+    static const unsigned int TransitionCacheSize = 8;
+
+public:
+    PipelineState(Program * program, VertexArray * vao, const StateBlock & state, Framebuffer * framebuffer = nullptr);
+
+    /** \brief Creates a pipeline state using the standard values of state; capabilities() and settings() are ignored.
+    */
+    PipelineState(Program * program, VertexArray * vao, const State * state, Framebuffer * framebuffer = nullptr);
+
+    Program * program() const;
+    VertexArray * vertexArray() const;
+    Framebuffer * framebuffer() const;
+    const StateBlock & state() const;
+
+    std::size_t hash() const;
+
+    bool operator==(const PipelineState & other) const;
+    bool operator!=(const PipelineState & other) const;
+
+    /** \brief Applies all parts; the state values only where they differ from the context's shadow.
+
+        Values the shadow holds and this pipeline state leaves unset are reset to their defaults.
+    */
+    void apply() const;
+
+    /** \brief Applies the parts that differ from a pipeline state known to be current.
+
+        If from is nullptr, this is the same as apply().
+    */
+    void apply(const PipelineState * from) const;
+
+    /** \brief Estimates the cost of switching from another pipeline state; nullptr for a full apply().
+    */
+    unsigned int switchCost(const PipelineState * from) const;
+
+protected:
+    virtual ~PipelineState();
+
+    struct Transition
+    {
+        unsigned long long from;
+
+        bool program;
+        bool vertexArray;
+        bool framebuffer;
+        StateBlock state;
+        unsigned int valueCount;
+
+        unsigned int cost;
+    };
+
+    void computeHash();
+    const Transition & transition(const PipelineState & from) const;
+
+protected:
+    unsigned long long m_serial;
+
+    ref_ptr<Program> m_program;
+    ref_ptr<VertexArray> m_vertexArray;
+    ref_ptr<Framebuffer> m_framebuffer;
+    StateBlock m_state;
+
+    std::size_t m_hash;
+    unsigned int m_cost;
+
+    /** Most recently used first */
+    mutable std::vector<Transition> m_transitions;
+};
+
+} // namespace globjects
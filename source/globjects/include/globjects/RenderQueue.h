@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Program;
+class State;
+class Texture;
+class VertexArray;
+
+
+/** \brief Sorts draw items by their state and submits them applying only the changes between consecutive items.
+
+    Each submitted item is assigned a packed 64-bit sort key, from most to
+    least significant: program, state, texture set, vertex array, and depth
+    (front to back). The keys are radix sorted - for large queues on multiple
+    threads - so items sharing expensive state end up adjacent. flush() then
+    walks the sorted items and only switches program, state, vertex array and
+    textures where they differ from the previous item.
+
+    The sort key only uses compact per-flush ids of the referenced objects,
+    so overflowing id ranges merely degrade the sorting; deltas are always
+    determined by comparing the objects themselves.
+
+    \code{.cpp}
+
+        RenderQueue * queue = new RenderQueue();
+
+        for (const Object & object : scene)
+        {
+            RenderQueue::Item item;
+            item.program = object.material->program;
+            item.vao = object.mesh->vao;
+            item.textures[0] = object.material->diffuse;
+            item.draw = RenderQueue::DrawParameters::elements(gl::GL_TRIANGLES, object.mesh->indexCount, gl::GL_UNSIGNED_INT);
+            item.depth = object.viewDepth / farPlane;
+
+            queue->submit(item);
+        }
+
+        queue->flush();
+
+        info() << queue->statistics().elided << " state changes elided";
+
+    \endcode
+ */
+class GLOBJECTS_API RenderQueue : public Referenced
+{
+public:
+    static const unsigned int MaxTextures = 8;
+
+    struct GLOBJECTS_API DrawParameters
+    {
+        DrawParameters();
+
+        static DrawParameters arrays(gl::GLenum mode, gl::GLint first, gl::GLsizei count, gl::GLsizei instanceCount = 1);
+        static DrawParameters elements(gl::GLenum mode, gl::GLsizei count, gl::GLenum type, const void * indices = nullptr, gl::GLsizei instanceCount = 1, gl::GLint baseVertex = 0);
+
+        gl::GLenum mode;
+
+        /** GL_NONE for non-indexed draws */
+        gl::GLenum type;
+
+        gl::GLint first;
+        gl::GLsizei count;
+        const void * indices;
+        gl::GLsizei instanceCount;
+        gl::GLint baseVertex;
+    };
+
+    struct GLOBJECTS_API Item
+    {
+        Item();
+
+        Program * program;
+        VertexArray * vao;
+
+        /** Optional; applied as a whole whenever it differs from the previous item's */
+        State * state;
+
+        /** Bound to GL_TEXTURE0 + i; nullptr leaves the unit untouched */
+        std::array<Texture *, MaxTextures> textures;
+
+        DrawParameters draw;
+
+        /** Normalized view depth in [0, 1], used to order items of equal state front to back */
+        float depth;
+
+        /** Optional; invoked right before the draw, e.g., to set per-draw uniforms */
+        std::function<void()> prepare;
+    };
+
+    struct Statistics
+    {
+        unsigned int items;
+
+        unsigned int programChanges;
+        unsigned int stateChanges;
+        unsigned int vertexArrayChanges;
+        unsigned int textureChanges;
+
+        /** State changes skipped as consecutive items shared the state */
+        unsigned int elided;
+    };
+
+public:
+    RenderQueue();
+
+    void submit(const Item & item);
+
+    unsigned int size() const;
+    void clear();
+
+    /** \brief Sorts and draws all submitted items and clears the queue.
+    */
+    void flush();
+
+    /** \brief Returns the statistics of the last flush().
+    */
+    const Statistics & statistics() const;
+
+    /** \brief Minimum number of items to sort using multiple threads.
+    */
+    void setParallelThreshold(unsigned int threshold);
+
+protected:
+    virtual ~RenderQueue();
+
+    using Key = std::uint64_t;
+
+    Key sortKey(const Item & item);
+    unsigned int compactId(std::unordered_map<const void *, unsigned int> & ids, const void * object);
+    unsigned int textureSetId(const Item & item);
+
+    void sort();
+
+    /** \brief Sorts the keys and the order of the items, splitting them into chunkCount chunks processed by one thread each.
+    */
+    void sort(unsigned int chunkCount);
+
+    void submitSorted();
+
+protected:
+    std::vector<Item> m_items;
+    std::vector<Key> m_keys;
+    std::vector<unsigned int> m_order;
+
+    std::unordered_map<const void *, unsigned int> m_programIds;
+    std::unordered_map<const void *, unsigned int> m_stateIds;
+    std::unordered_map<const void *, unsigned int> m_vertexArrayIds;
+    std::unordered_map<std::size_t, unsigned int> m_textureSetIds;
+
+    unsigned int m_parallelThreshold;
+
+    Statistics m_statistics;
+};
+
+} // namespace globjects
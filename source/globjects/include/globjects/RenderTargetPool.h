@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Texture;
+class Renderbuffer;
+
+
+/** \brief Recycles transient render targets between frames and passes.
+
+    Textures and renderbuffers are requested by target, internal format, size
+    and sample count and are handed out exclusively until the end of the frame
+    (nextFrame()) or until they are given back by release(). Targets that were
+    not requested for maxUnusedFrames() frames are deleted.
+
+    Pooled single sampled textures are allocated with immutable storage. If no
+    free texture of the requested format exists, a free texture of a view
+    compatible format (same target, size, and texel size class) is aliased
+    using Texture::textureView() instead of allocating new memory. While a
+    view is handed out, its underlying storage is considered in use as well.
+
+    \code{.cpp}
+
+        RenderTargetPool * pool = new RenderTargetPool();
+
+        // per pass
+        Texture * color = pool->texture(GL_TEXTURE_2D, GL_RGBA8, glm::ivec3(viewport, 1));
+        Renderbuffer * depth = pool->renderbuffer(GL_DEPTH_COMPONENT24, viewport);
+
+        // per frame
+        pool->nextFrame();
+
+    \endcode
+
+    \see http://www.opengl.org/registry/specs/ARB/texture_view.txt
+ */
+class GLOBJECTS_API RenderTargetPool : public Referenced
+{
+public:
+    struct FrameStatistics
+    {
+        FrameStatistics();
+
+        unsigned int created;
+        unsigned int reused;
+        unsigned int aliased;
+        unsigned int deleted;
+    };
+
+public:
+    RenderTargetPool(unsigned int maxUnusedFrames = 3);
+
+    unsigned int maxUnusedFrames() const;
+    void setMaxUnusedFrames(unsigned int frames);
+
+    /** \brief Hands out a texture for exclusive use within the current frame.
+        \param size width, height and depth or number of layers (ignored for 2D and cube map targets)
+        \param samples number of samples for multisample targets, 0 otherwise
+    */
+    Texture * texture(gl::GLenum target, gl::GLenum internalFormat, const glm::ivec3 & size, gl::GLsizei samples = 0);
+    Texture * texture2D(gl::GLenum internalFormat, const glm::ivec2 & size);
+
+    Renderbuffer * renderbuffer(gl::GLenum internalFormat, const glm::ivec2 & size, gl::GLsizei samples = 0);
+
+    /** \brief Returns a target to the pool before the end of the frame.
+        Subsequent requests within the same frame may hand it out again.
+    */
+    void release(Texture * texture);
+    void release(Renderbuffer * renderbuffer);
+
+    /** \brief Returns all targets to the pool and deletes the ones unused for maxUnusedFrames().
+    */
+    void nextFrame();
+
+    /** \brief Deletes all targets that are not handed out currently.
+    */
+    void clear();
+
+    const FrameStatistics & currentFrameStatistics() const;
+    const FrameStatistics & lastFrameStatistics() const;
+
+    /** \brief Returns the internal format's view class (ARB_texture_view) or 0 if it is not view compatible to other formats.
+    */
+    static unsigned int viewClass(gl::GLenum internalFormat);
+
+protected:
+    virtual ~RenderTargetPool();
+
+    struct Key
+    {
+        gl::GLenum target;
+        gl::GLenum internalFormat;
+        glm::ivec3 size;
+        gl::GLsizei samples;
+
+        bool operator==(const Key & other) const;
+        bool hasSameExtent(const Key & other) const;
+    };
+
+    struct TextureAllocation
+    {
+        Key key;
+        ref_ptr<Texture> texture;
+        std::vector<std::pair<gl::GLenum, ref_ptr<Texture>>> views;
+
+        Texture * inUse;
+        unsigned long long lastUsed;
+    };
+
+    struct RenderbufferAllocation
+    {
+        Key key;
+        ref_ptr<Renderbuffer> renderbuffer;
+
+        bool inUse;
+        unsigned long long lastUsed;
+    };
+
+    Texture * acquire(TextureAllocation & allocation, Texture * texture);
+    Texture * findView(TextureAllocation & allocation, gl::GLenum internalFormat) const;
+    Texture * createView(TextureAllocation & allocation, gl::GLenum internalFormat);
+
+    static Texture * createTexture(const Key & key);
+    static gl::GLuint layerCount(const Key & key);
+
+protected:
+    unsigned int m_maxUnusedFrames;
+    unsigned long long m_frame;
+
+    std::vector<TextureAllocation> m_textures;
+    std::vector<RenderbufferAllocation> m_renderbuffers;
+
+    FrameStatistics m_currentFrame;
+    FrameStatistics m_lastFrame;
+};
+
+} // namespace globjects
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Sampler;
+
+
+/** \brief Complete, immutable set of sampler parameters.
+
+    Default constructed descriptions match the initial OpenGL sampler state.
+ */
+struct GLOBJECTS_API SamplerDescription
+{
+    SamplerDescription();
+    SamplerDescription(gl::GLenum minFilter, gl::GLenum magFilter, gl::GLenum wrap, gl::GLfloat maxAnisotropy = 1.0f);
+
+    bool operator==(const SamplerDescription & other) const;
+    bool operator!=(const SamplerDescription & other) const;
+
+    std::size_t hash() const;
+
+    gl::GLenum minFilter;
+    gl::GLenum magFilter;
+
+    gl::GLenum wrapS;
+    gl::GLenum wrapT;
+    gl::GLenum wrapR;
+
+    gl::GLfloat minLod;
+    gl::GLfloat maxLod;
+    gl::GLfloat lodBias;
+
+    /** Requires EXT_texture_filter_anisotropic if greater than 1.0 */
+    gl::GLfloat maxAnisotropy;
+
+    gl::GLenum compareMode;
+    gl::GLenum compareFunc;
+
+    gl::GLfloat borderColor[4];
+};
+
+} // namespace globjects
+
+
+namespace std
+{
+
+template <>
+struct GLOBJECTS_API hash<globjects::SamplerDescription>
+{
+    size_t operator()(const globjects::SamplerDescription & description) const;
+};
+
+} // namespace std
+
+
+namespace globjects
+{
+
+/** \brief Deduplicates sampler objects by their parameters.
+
+    Each distinct SamplerDescription results in exactly one Sampler, created
+    once with all parameters set. Thus, materials using the same sampling
+    parameters share the same sampler and state comparisons reduce to pointer
+    equality. The returned samplers are const, as they are shared.
+
+    \code{.cpp}
+
+        SamplerCache * cache = new SamplerCache();
+
+        const Sampler * sampler = cache->sampler(SamplerDescription(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, GL_REPEAT, 8.0f));
+        sampler->bind(0);
+
+    \endcode
+
+    \see Sampler
+ */
+class GLOBJECTS_API SamplerCache : public Referenced
+{
+public:
+    SamplerCache();
+
+    const Sampler * sampler(const SamplerDescription & description);
+
+    std::size_t size() const;
+
+    /** \brief Deletes samplers that are not referenced outside of the cache.
+    */
+    void removeUnused();
+    void clear();
+
+protected:
+    virtual ~SamplerCache();
+
+    static Sampler * createSampler(const SamplerDescription & description);
+
+protected:
+    std::unordered_map<SamplerDescription, ref_ptr<Sampler>> m_samplers;
+};
+
+} // namespace globjects
+
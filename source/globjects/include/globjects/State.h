@@ -9,6 +9,7 @@
 
 #include <globjects/globjects_api.h>
 #include <globjects/AbstractState.h>
+#include <globjects/StateBlock.h>
 
 namespace globjects
 {
@@ -17,6 +18,41 @@ class StateSetting;
 class Capability;
 
 
+/** \brief Set of capabilities and settings, applied at once or immediately when set.
+
+    The standard capabilities and settings are stored in a flat StateBlock,
+    see block(). Only the remaining ones, e.g., indexed capabilities and
+    pixel store parameters, are stored as Capability and StateSetting
+    objects and returned by capabilities() and settings().
+
+    Each context keeps a shadow of the values last set through globjects.
+    apply() only issues the capabilities and settings that differ from this
+    shadow, so switching between similar states costs only their differences.
+    If foreign code changes the state of the context, invalidateShadow() has
+    to be called before the next apply().
+
+    With tracking enabled, see setTracking(), currentState() returns a copy
+    of the shadow instead of querying the context with dozens of glGet
+    calls. The shadow is then filled by resync(), which has to be called
+    again whenever foreign code changed the state of the context.
+
+    \code{.cpp}
+
+        State * opaque = new State(State::DeferredMode);
+        opaque->enable(gl::GL_DEPTH_TEST);
+        opaque->disable(gl::GL_BLEND);
+
+        State * transparent = new State(State::DeferredMode);
+        transparent->enable(gl::GL_DEPTH_TEST);
+        transparent->enable(gl::GL_BLEND);
+        transparent->blendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+
+        opaque->apply();
+        // ...
+        transparent->applyDiff(*opaque); // issues only blend enable and blend func
+
+    \endcode
+ */
 class GLOBJECTS_API State : public AbstractState, public Referenced
 {
 public:
@@ -26,16 +62,60 @@ public:
         ImmediateMode
     };
 
+    struct Statistics
+    {
+        /** Capabilities and settings issued to OpenGL */
+        unsigned long long issued;
+
+        /** Capabilities and settings skipped as the context had them set already */
+        unsigned long long elided;
+    };
+
 public:
     State(Mode = ImmediateMode);
 
+    /** \brief Creates a deferred state from standard values, without applying them.
+    */
+    explicit State(const StateBlock & block);
+
+    /** \brief Returns the state of the current context, queried or from the tracked shadow.
+    */
     static State * currentState();
 
+    /** \brief Answers currentState() of the current context from the tracked shadow; enabling resyncs it.
+    */
+    static void setTracking(bool enabled);
+    static bool isTracking();
+
+    /** \brief Queries the state of the current context into its shadow, e.g., after foreign code changed it.
+    */
+    static void resync();
+
+    /** \brief Returns the issued and elided calls of the current context since the last resetStatistics().
+    */
+    static Statistics statistics();
+    static void resetStatistics();
+
+    /** \brief Forgets the tracked state of the current context, e.g., after foreign code changed it.
+
+        With tracking enabled, resync() should be used instead.
+    */
+    static void invalidateShadow();
+
     void setMode(Mode mode);
     Mode mode() const;
 
+    /** \brief Applies the capabilities and settings that differ from the current context's shadow.
+    */
     void apply();
 
+    /** \brief Applies the capabilities and settings that differ from a state known to be current.
+
+        Neither the shadow is consulted nor are values this state shares with
+        from reissued. Values set by from only are left untouched.
+    */
+    void applyDiff(const State & from);
+
     virtual void enable(gl::GLenum capability) override;
     virtual void disable(gl::GLenum capability) override;
     virtual bool isEnabled(gl::GLenum capability) const override;
@@ -44,6 +124,9 @@ public:
     virtual bool isEnabled(gl::GLenum capability, int index) const override;
 
     virtual void add(StateSetting * setting) override;
+    virtual void add(const StateBlock & values) override;
+
+    const StateBlock & block() const;
 
     Capability * capability(gl::GLenum capability);
     const Capability * capability(gl::GLenum capability) const;
@@ -55,6 +138,11 @@ public:
     std::vector<const StateSetting *> settings() const;
 
 protected:
+    static State * queriedState();
+    static State * trackedState();
+
+    void setCapability(gl::GLenum capability, bool enabled);
+
     void addCapability(Capability * capability);
     Capability * getCapability(gl::GLenum capability);
     const Capability * getCapability(gl::GLenum capability) const;
@@ -63,6 +151,7 @@ protected:
     virtual ~State();
 
     Mode m_mode;
+    StateBlock m_block;
     std::unordered_map<gl::GLenum, Capability *> m_capabilities;
     std::unordered_map<StateSettingType, StateSetting *> m_settings;
 };
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class StateSetting;
+
+
+/** \brief Flat, fixed layout encoding of the standard pipeline state.
+
+    Each setting is stored as a field of 32-bit words in one contiguous
+    array, together with bit masks of the set fields and of the set and
+    enabled standard capabilities. Unset fields are zero, so copies,
+    comparisons, ordering and hashing operate on plain memory without any
+    allocation. Faces are stored separately, e.g., stencilFunc() sets the
+    front and back field. Floating point values are stored in single
+    precision, including the depth range and clear depth.
+
+    Capabilities not listed as standard, indexed capabilities and settings
+    without a field, e.g., pixel store parameters, are kept by State as
+    Capability and StateSetting objects instead.
+
+    \code{.cpp}
+
+        StateBlock opaque;
+        opaque.setEnabled(gl::GL_DEPTH_TEST, true);
+        opaque.depthFunc(gl::GL_LESS);
+
+        StateBlock transparent = opaque;
+        transparent.setEnabled(gl::GL_BLEND, true);
+        transparent.blendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+
+        transparent.applyDiff(opaque); // issues glEnable(GL_BLEND) and glBlendFuncSeparate only
+
+    \endcode
+
+    \see State
+ */
+class GLOBJECTS_API StateBlock
+{
+public:
+    enum Field : unsigned int
+    {
+        BlendColor,
+        BlendFunc,
+        ClearColor,
+        ClearDepth,
+        ClearStencil,
+        ColorMask,
+        CullFace,
+        DepthFunc,
+        DepthMask,
+        DepthRange,
+        FrontFace,
+        LogicOp,
+        PointSize,
+        PolygonModeFront,
+        PolygonModeBack,
+        PolygonOffset,
+        PrimitiveRestartIndex,
+        ProvokingVertex,
+        SampleCoverage,
+        Scissor,
+        StencilFuncFront,
+        StencilFuncBack,
+        StencilOpFront,
+        StencilOpBack,
+        StencilMaskFront,
+        StencilMaskBack,
+        FieldCount
+    };
+
+    static const unsigned int ValueCount = 52;
+
+    /** \brief Returns whether capability is stored in the capability masks.
+    */
+    static bool isStandardCapability(gl::GLenum capability);
+
+    /** \brief Returns the initial values of a context.
+
+        Excluded are the clear values, which do not affect drawing, and the
+        scissor box and debug output, whose initial values depend on the
+        window and context flags.
+    */
+    static const StateBlock & defaults();
+
+public:
+    StateBlock();
+
+    bool isEmpty() const;
+
+    /** \brief Returns the number of set fields and capabilities.
+    */
+    unsigned int count() const;
+
+    bool isSet(Field field) const;
+    std::uint32_t fields() const;
+    void unset(std::uint32_t fields);
+
+    bool isSet(gl::GLenum capability) const;
+    bool isEnabled(gl::GLenum capability) const;
+    void setEnabled(gl::GLenum capability, bool enabled);
+    void unsetCapability(gl::GLenum capability);
+    void unsetCapabilities();
+
+    void blendColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha);
+    void blendFunc(gl::GLenum sFactor, gl::GLenum dFactor);
+    void blendFuncSeparate(gl::GLenum srcRGB, gl::GLenum dstRGB, gl::GLenum srcAlpha, gl::GLenum dstAlpha);
+    void clearColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha);
+    void clearDepth(gl::GLfloat depth);
+    void clearStencil(gl::GLint s);
+    void colorMask(gl::GLboolean red, gl::GLboolean green, gl::GLboolean blue, gl::GLboolean alpha);
+    void cullFace(gl::GLenum mode);
+    void depthFunc(gl::GLenum func);
+    void depthMask(gl::GLboolean flag);
+    void depthRange(gl::GLfloat nearVal, gl::GLfloat farVal);
+    void frontFace(gl::GLenum winding);
+    void logicOp(gl::GLenum opcode);
+    void pointSize(gl::GLfloat size);
+    void polygonMode(gl::GLenum face, gl::GLenum mode);
+    void polygonOffset(gl::GLfloat factor, gl::GLfloat units);
+    void primitiveRestartIndex(gl::GLuint index);
+    void provokingVertex(gl::GLenum provokeMode);
+    void sampleCoverage(gl::GLfloat value, gl::GLboolean invert);
+    void scissor(gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height);
+    void stencilFuncSeparate(gl::GLenum face, gl::GLenum func, gl::GLint ref, gl::GLuint mask);
+    void stencilMaskSeparate(gl::GLenum face, gl::GLuint mask);
+    void stencilOpSeparate(gl::GLenum face, gl::GLenum stencilFail, gl::GLenum depthFail, gl::GLenum depthPass);
+
+    /** \brief Returns the set standard capabilities.
+    */
+    std::vector<gl::GLenum> capabilities() const;
+
+    /** \brief Returns a new StateSetting for each set field, faces specialized as by AbstractState; the caller takes ownership.
+    */
+    std::vector<StateSetting *> settings() const;
+
+    /** \brief Overwrites the fields and capabilities set in other.
+    */
+    void merge(const StateBlock & other);
+
+    /** \brief Returns this block plus the values only previous sets, reset to defaults().
+
+        Applied after previous, no value of previous remains that this block leaves unset.
+    */
+    StateBlock completed(const StateBlock & previous) const;
+
+    void apply() const;
+
+    /** \brief Applies the fields and capabilities that are not set to the same value in from.
+
+        \return number of issued fields and capabilities
+    */
+    unsigned int applyDiff(const StateBlock & from) const;
+
+    /** \brief Returns the fields and capabilities applyDiff() would issue.
+    */
+    StateBlock difference(const StateBlock & from) const;
+
+    bool operator==(const StateBlock & other) const;
+    bool operator!=(const StateBlock & other) const;
+    bool operator<(const StateBlock & other) const;
+
+    std::size_t hash() const;
+
+protected:
+    void set(Field field, const std::uint32_t * values);
+    void setFace(Field front, Field back, gl::GLenum face, const std::uint32_t * values);
+    bool equals(const StateBlock & other, Field field) const;
+
+    std::uint32_t changedCapabilities(const StateBlock & from) const;
+    std::uint32_t changedFields(const StateBlock & from) const;
+
+    void applyCapabilities(std::uint32_t capabilities) const;
+    void applyFields(std::uint32_t fields) const;
+
+protected:
+    std::uint32_t m_fields;
+    std::uint32_t m_capabilities;
+    std::uint32_t m_enabled;
+    std::array<std::uint32_t, ValueCount> m_values;
+};
+
+} // namespace globjects
+
+
+namespace std
+{
+
+template <>
+struct GLOBJECTS_API hash<globjects::StateBlock>
+{
+    size_t operator()(const globjects::StateBlock & block) const;
+};
+
+} // namespace std
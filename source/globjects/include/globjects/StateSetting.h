@@ -22,6 +22,8 @@ public:
     bool operator==(const StateSettingType & other) const;
     std::size_t hash() const;
 
+    void * functionIdentifier() const;
+
     void specializeType(gl::GLenum subtype);
 
 protected:
@@ -42,9 +44,22 @@ public:
 
     void apply();
 
+    /** \brief Returns a copy, or nullptr if the function call can not be copied (AbstractFunctionCall::clone()).
+    */
+    StateSetting * clone() const;
+
+    /** \brief Returns whether other is of the same type and sets the same values.
+    */
+    bool equals(const StateSetting & other) const;
+
     StateSettingType & type();
     const StateSettingType & type() const;
 
+private:
+    // owns the function call, copies are made with clone()
+    StateSetting(const StateSetting &) = delete;
+    StateSetting & operator=(const StateSetting &) = delete;
+
 protected:
     AbstractFunctionCall * m_functionCall;
     StateSettingType m_type;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+/** \brief Saves and restores the standard pipeline state of the current context around nested passes.
+
+    push() copies the context's shadow state, limited to the groups in the
+    mask, without any glGet. pop() restores only the values that changed
+    since, i.e., everything set through globjects in between and values the
+    shadow lost track of, e.g., by State::invalidateShadow(). A pass thus
+    costs what it changes instead of the whole state.
+
+    Values unknown to the shadow at push() can not be restored; enable
+    State::setTracking() to have the complete state known. Only standard
+    values are covered, see StateBlock.
+
+    \code{.cpp}
+
+        StateStack::push(StateStack::Blend | StateStack::Depth | StateStack::Capabilities);
+
+        overlayState->apply();
+        drawOverlay();
+
+        StateStack::pop(); // restores only what overlayState changed
+
+    \endcode
+
+    \see State
+ */
+class GLOBJECTS_API StateStack
+{
+public:
+    enum Group : unsigned int
+    {
+        Capabilities = 1 << 0,
+        Blend = 1 << 1,
+        Depth = 1 << 2,
+        Stencil = 1 << 3,
+        Rasterization = 1 << 4,
+        Scissor = 1 << 5,
+        Clear = 1 << 6,
+        ColorMask = 1 << 7,
+        All = 0xff
+    };
+
+public:
+    static void push(unsigned int mask = All);
+
+    /** \brief Restores the values saved by the matching push() that changed since.
+
+        \return number of issued capabilities and settings
+    */
+    static unsigned int pop();
+
+    static unsigned int depth();
+
+private:
+    StateStack();
+};
+
+} // namespace globjects
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Buffer;
+class Sync;
+class Texture;
+
+
+/** \brief Streams texture data through a pool of pixel unpack buffers.
+
+    Uploads are queued by subImage2D() and subImage3D() and return a token
+    identifying their completion. Each call to process() copies pending rows
+    into a free staging buffer and issues the texture update from that buffer,
+    until the time budget is exhausted or no staging buffer is available.
+    Staging buffers are fenced and reused once the GPU consumed them. If
+    ARB_buffer_storage is available, they are persistently mapped.
+
+    The client memory passed to an upload has to remain valid until the upload
+    is complete (isComplete()). Rows are expected to be tightly packed with
+    respect to the unpack alignment at the time the upload is queued; other
+    unpack parameters (row length, image height, skips) are not supported.
+
+    \code{.cpp}
+
+        TextureUploader * uploader = new TextureUploader();
+
+        TextureUploader::Token token = texture->subImage2DAsync(0, glm::ivec2(0), size, GL_RGBA, GL_UNSIGNED_BYTE, data, uploader);
+
+        // per frame
+        uploader->process();
+
+        if (uploader->isComplete(token))
+            delete[] data;
+
+    \endcode
+
+    \see Texture::subImage2DAsync
+    \see http://www.opengl.org/wiki/Pixel_Buffer_Object
+ */
+class GLOBJECTS_API TextureUploader : public Referenced
+{
+public:
+    using Token = unsigned long long;
+
+public:
+    TextureUploader(gl::GLsizeiptr stagingBufferSize = 4 * 1024 * 1024, unsigned int stagingBufferCount = 3);
+
+    const std::chrono::microseconds & budget() const;
+    void setBudget(const std::chrono::microseconds & budget);
+
+    Token subImage2D(Texture * texture, gl::GLint level, const glm::ivec2 & offset, const glm::ivec2 & size, gl::GLenum format, gl::GLenum type, const gl::GLvoid * data);
+    Token subImage3D(Texture * texture, gl::GLint level, const glm::ivec3 & offset, const glm::ivec3 & size, gl::GLenum format, gl::GLenum type, const gl::GLvoid * data);
+
+    /** \brief Issues pending uploads within budget(); to be called once per frame.
+        At least one chunk is issued per call if a staging buffer is available.
+    */
+    void process();
+    void process(const std::chrono::microseconds & budget);
+
+    bool isComplete(Token token);
+
+    /** \brief Blocks until the upload identified by token is complete.
+    */
+    void finish(Token token);
+    void finish();
+
+    std::size_t pendingCount() const;
+
+protected:
+    virtual ~TextureUploader();
+
+    struct Upload
+    {
+        Token token;
+
+        ref_ptr<Texture> texture;
+        bool is3D;
+        gl::GLint level;
+        glm::ivec3 offset;
+        glm::ivec3 size;
+        gl::GLenum format;
+        gl::GLenum type;
+
+        const char * data;
+        gl::GLint alignment;
+        gl::GLsizeiptr packedRowSize;
+        gl::GLsizeiptr rowSize;
+
+        gl::GLint nextRow;
+    };
+
+    struct StagingBuffer
+    {
+        ref_ptr<Buffer> buffer;
+        char * mapping;
+
+        gl::GLsizeiptr used;
+        ref_ptr<Sync> fence;
+    };
+
+    Token enqueue(Upload & upload, const gl::GLvoid * data);
+
+    bool issueChunks(const std::chrono::microseconds & budget);
+    void issueChunk(Upload & upload, StagingBuffer & staging, gl::GLsizeiptr stagingOffset, gl::GLint rows);
+    static void update(Upload & upload, gl::GLint rows, const gl::GLvoid * pixels);
+
+    StagingBuffer * acquireStagingBuffer();
+    void fence(const std::vector<StagingBuffer *> & stagingBuffers);
+    void reclaim();
+    void waitForOldest();
+
+protected:
+    gl::GLsizeiptr m_stagingBufferSize;
+    bool m_persistent;
+    std::vector<StagingBuffer> m_stagingBuffers;
+
+    std::chrono::microseconds m_budget;
+
+    std::deque<Upload> m_pending;
+    std::deque<std::pair<Token, ref_ptr<Sync>>> m_fences;
+
+    Token m_nextToken;
+    Token m_issued;
+    Token m_fenced;
+    Token m_completed;
+};
+
+} // namespace globjects
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/Referenced.h>
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Framebuffer;
+class FramebufferCapture;
+class RenderTargetPool;
+
+
+/** \brief Renders images larger than the viewport or renderbuffer limits tile by tile.
+
+    The image is split into tiles of at most tileSize(). For each tile, the
+    draw callback renders into a tile sized framebuffer using the tile's
+    projection, which restricts the given projection to the tile's part of
+    the image. The tile's pixels are read back with a FramebufferCapture,
+    overlapping the read back with rendering the following tiles, and handed
+    to the tile callback. Only tile sized storage is allocated, regardless of
+    the image size.
+
+    Pixels are tightly packed (pack alignment of 1) and, as in OpenGL, the
+    first row is the bottom row of the tile.
+
+    \code{.cpp}
+
+        TiledRenderer * renderer = new TiledRenderer(glm::ivec2(32768, 32768));
+
+        renderer->render(projection, [&](const TiledRenderer::Tile & tile)
+        {
+            gl::glClear(gl::GL_COLOR_BUFFER_BIT | gl::GL_DEPTH_BUFFER_BIT);
+            scene.draw(tile.projection * view);
+        }, TiledRenderer::rawFileWriter("image.raw", renderer->imageSize(), 4));
+
+    \endcode
+ */
+class GLOBJECTS_API TiledRenderer : public Referenced
+{
+public:
+    struct Tile
+    {
+        unsigned int index;
+
+        glm::ivec2 offset;
+        glm::ivec2 size;
+
+        /** Projection restricted to this tile */
+        glm::mat4 projection;
+    };
+
+    using DrawCallback = std::function<void(const Tile &)>;
+    using TileCallback = std::function<void(const Tile &, const void * pixels)>;
+
+public:
+    /** \brief Creates a renderer for an image of imageSize pixels.
+        \param tileSize maximum tile size; clamped to GL_MAX_VIEWPORT_DIMS and GL_MAX_RENDERBUFFER_SIZE
+    */
+    TiledRenderer(const glm::ivec2 & imageSize, const glm::ivec2 & tileSize = glm::ivec2(2048, 2048));
+
+    const glm::ivec2 & imageSize() const;
+    const glm::ivec2 & tileSize() const;
+
+    /** \brief Sets the color attachment's internal format and the format and type used for read back.
+    */
+    void setColorFormat(gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type);
+
+    /** \brief Sets the depth attachment's internal format; GL_NONE omits the depth attachment.
+    */
+    void setDepthFormat(gl::GLenum internalFormat);
+
+    const std::vector<Tile> & tiles(const glm::mat4 & projection);
+
+    void render(const glm::mat4 & projection, const DrawCallback & draw, const TileCallback & receive);
+
+    /** \brief Returns a tile callback that writes the image row by row to a raw file.
+        The file is written in OpenGL row order, i.e., bottom row first.
+    */
+    static TileCallback rawFileWriter(const std::string & fileName, const glm::ivec2 & imageSize, int bytesPerPixel);
+
+    static glm::mat4 tileProjection(const glm::ivec2 & imageSize, const glm::ivec2 & tileOffset, const glm::ivec2 & tileSize);
+
+protected:
+    virtual ~TiledRenderer();
+
+protected:
+    glm::ivec2 m_imageSize;
+    glm::ivec2 m_tileSize;
+
+    gl::GLenum m_colorInternalFormat;
+    gl::GLenum m_colorFormat;
+    gl::GLenum m_colorType;
+    gl::GLenum m_depthInternalFormat;
+
+    std::vector<Tile> m_tiles;
+
+    ref_ptr<Framebuffer> m_fbo;
+    ref_ptr<RenderTargetPool> m_pool;
+    ref_ptr<FramebufferCapture> m_capture;
+};
+
+} // namespace globjects
@@ -37,6 +37,9 @@ public:
 
     virtual void accept(ObjectVisitor & visitor) override;
 
+    /** \brief Binds the vertex array, unless it was the last one bound through globjects in the current context.
+        After binding vertex arrays without globjects, call invalidateBindings().
+    */
     void bind() const;
     static void unbind();
 
@@ -58,6 +61,7 @@ public:
 
     void multiDrawArrays(gl::GLenum mode, gl::GLint * first, const gl::GLsizei * count, gl::GLsizei drawCount) const;
     void multiDrawArraysIndirect(gl::GLenum mode, const void * indirect, gl::GLsizei drawCount, gl::GLsizei stride) const;
+    void multiDrawArraysIndirectCount(gl::GLenum mode, const void * indirect, gl::GLintptr drawCount, gl::GLsizei maxDrawCount, gl::GLsizei stride) const;
 
     void drawElements(gl::GLenum mode, gl::GLsizei count, gl::GLenum type, const void * indices = nullptr) const;
     void drawElementsBaseVertex(gl::GLenum mode, gl::GLsizei count, gl::GLenum type, const void * indices, gl::GLint baseVertex) const;
@@ -69,6 +73,7 @@ public:
     void multiDrawElements(gl::GLenum mode, const gl::GLsizei * count, gl::GLenum type, const void ** indices, gl::GLsizei drawCount) const;
     void multiDrawElementsBaseVertex(gl::GLenum mode, const gl::GLsizei * count, gl::GLenum type, const void ** indices, gl::GLsizei drawCount, gl::GLint * baseVertex) const;
     void multiDrawElementsIndirect(gl::GLenum mode, gl::GLenum type, const void * indirect, gl::GLsizei drawCount, gl::GLsizei stride) const;
+    void multiDrawElementsIndirectCount(gl::GLenum mode, gl::GLenum type, const void * indirect, gl::GLintptr drawCount, gl::GLsizei maxDrawCount, gl::GLsizei stride) const;
 
     void drawRangeElements(gl::GLenum mode, gl::GLuint start, gl::GLuint end, gl::GLsizei count, gl::GLenum type, const void * indices = nullptr) const;
     void drawRangeElementsBaseVertex(gl::GLenum mode, gl::GLuint start, gl::GLuint end, gl::GLsizei count, gl::GLenum type, const void * indices, gl::GLint baseVertex) const;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <type_traits>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/globjects_api.h>
+
+namespace globjects
+{
+
+class Buffer;
+class VertexArray;
+
+
+/** \brief Attribute conversions, selecting glVertexAttribFormat, glVertexAttribIFormat or glVertexAttribLFormat.
+
+    Native keeps the component type, i.e., integer components are read as
+    integers and doubles as doubles. Normalized maps integer components to
+    [0, 1] or [-1, 1] floats and Converted casts them to floats.
+*/
+struct Native {};
+struct Normalized {};
+struct Converted {};
+
+
+/** \brief Component count, type, and category of a C++ type used as vertex attribute.
+
+    Specialize this for further types, e.g., packed colors.
+*/
+template <typename T>
+struct VertexAttributeType;
+
+template <gl::GLint Size, gl::GLenum Type, bool Integral, bool Double>
+struct VertexAttributeTypeBase
+{
+    static const gl::GLint size = Size;
+    static const gl::GLenum type = Type;
+    static const bool integral = Integral;
+    static const bool isDouble = Double;
+};
+
+template <> struct VertexAttributeType<float> : VertexAttributeTypeBase<1, gl::GLenum::GL_FLOAT, false, false> {};
+template <> struct VertexAttributeType<glm::vec2> : VertexAttributeTypeBase<2, gl::GLenum::GL_FLOAT, false, false> {};
+template <> struct VertexAttributeType<glm::vec3> : VertexAttributeTypeBase<3, gl::GLenum::GL_FLOAT, false, false> {};
+template <> struct VertexAttributeType<glm::vec4> : VertexAttributeTypeBase<4, gl::GLenum::GL_FLOAT, false, false> {};
+
+template <> struct VertexAttributeType<int> : VertexAttributeTypeBase<1, gl::GLenum::GL_INT, true, false> {};
+template <> struct VertexAttributeType<glm::ivec2> : VertexAttributeTypeBase<2, gl::GLenum::GL_INT, true, false> {};
+template <> struct VertexAttributeType<glm::ivec3> : VertexAttributeTypeBase<3, gl::GLenum::GL_INT, true, false> {};
+template <> struct VertexAttributeType<glm::ivec4> : VertexAttributeTypeBase<4, gl::GLenum::GL_INT, true, false> {};
+
+template <> struct VertexAttributeType<unsigned int> : VertexAttributeTypeBase<1, gl::GLenum::GL_UNSIGNED_INT, true, false> {};
+template <> struct VertexAttributeType<glm::uvec2> : VertexAttributeTypeBase<2, gl::GLenum::GL_UNSIGNED_INT, true, false> {};
+template <> struct VertexAttributeType<glm::uvec3> : VertexAttributeTypeBase<3, gl::GLenum::GL_UNSIGNED_INT, true, false> {};
+template <> struct VertexAttributeType<glm::uvec4> : VertexAttributeTypeBase<4, gl::GLenum::GL_UNSIGNED_INT, true, false> {};
+
+template <> struct VertexAttributeType<double> : VertexAttributeTypeBase<1, gl::GLenum::GL_DOUBLE, false, true> {};
+template <> struct VertexAttributeType<glm::dvec2> : VertexAttributeTypeBase<2, gl::GLenum::GL_DOUBLE, false, true> {};
+template <> struct VertexAttributeType<glm::dvec3> : VertexAttributeTypeBase<3, gl::GLenum::GL_DOUBLE, false, true> {};
+template <> struct VertexAttributeType<glm::dvec4> : VertexAttributeTypeBase<4, gl::GLenum::GL_DOUBLE, false, true> {};
+
+
+/** \brief Declares the vertex attribute at location Index as a member of type T.
+*/
+template <gl::GLuint Index, typename T, typename Conversion = Native>
+struct Attr
+{
+    using Type = T;
+    using Traits = VertexAttributeType<T>;
+
+    static const gl::GLuint index = Index;
+    static const gl::GLint size = Traits::size;
+
+    static_assert(!std::is_same<Conversion, Normalized>::value || Traits::integral, "Only integer attributes can be normalized");
+
+    static void apply(VertexArray * vao, const Buffer * vbo, gl::GLint baseOffset, gl::GLuint relativeOffset, gl::GLint stride);
+};
+
+
+/** \brief Compile time description of an interleaved vertex, applied to a VertexArray in one call.
+
+    The attributes are laid out in declaration order without padding, so
+    sizes, types, offsets, and the stride follow from the attribute types.
+    When applied for a vertex struct, its size is checked against the
+    stride, i.e., the struct has to declare the attributes' members in the
+    same order.
+
+    Each attribute uses the vertex attribute binding of its location. The
+    binding is configured attribute, format, and buffer last, so the legacy
+    implementation specifies each attribute pointer exactly once.
+
+    \code{.cpp}
+
+        struct Vertex
+        {
+            glm::vec3 position;
+            glm::vec3 normal;
+            glm::vec2 texCoord;
+        };
+
+        using Layout = VertexLayout<Attr<0, glm::vec3>, Attr<1, glm::vec3>, Attr<2, glm::vec2>>;
+
+        Layout::apply<Vertex>(vao, vertexBuffer);
+
+    \endcode
+
+    \see VertexAttributeBinding
+ */
+template <typename... Attributes>
+class VertexLayout
+{
+public:
+    static gl::GLint stride();
+    static unsigned int attributeCount();
+
+    /** \brief Configures and enables all attributes to read from vbo, starting at baseOffset.
+    */
+    static void apply(VertexArray * vao, const Buffer * vbo, gl::GLint baseOffset = 0);
+
+    template <typename Vertex>
+    static void apply(VertexArray * vao, const Buffer * vbo, gl::GLint baseOffset = 0);
+};
+
+} // namespace globjects
+
+#include <globjects/VertexLayout.hpp>
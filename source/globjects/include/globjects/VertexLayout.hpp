@@ -0,0 +1,88 @@
+#pragma once
+
+#include <globjects/VertexLayout.h>
+
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/VertexArray.h>
+#include <globjects/VertexAttributeBinding.h>
+
+namespace globjects
+{
+
+template <typename... Attributes>
+struct VertexLayoutAttributes;
+
+template <>
+struct VertexLayoutAttributes<>
+{
+    static const gl::GLint size = 0;
+    static const unsigned int count = 0;
+
+    static void apply(VertexArray *, const Buffer *, gl::GLint, gl::GLuint, gl::GLint)
+    {
+    }
+};
+
+template <typename First, typename... Rest>
+struct VertexLayoutAttributes<First, Rest...>
+{
+    static const gl::GLint size = static_cast<gl::GLint>(sizeof(typename First::Type)) + VertexLayoutAttributes<Rest...>::size;
+    static const unsigned int count = 1 + VertexLayoutAttributes<Rest...>::count;
+
+    static void apply(VertexArray * vao, const Buffer * vbo, gl::GLint baseOffset, gl::GLuint relativeOffset, gl::GLint stride)
+    {
+        First::apply(vao, vbo, baseOffset, relativeOffset, stride);
+
+        VertexLayoutAttributes<Rest...>::apply(vao, vbo, baseOffset, relativeOffset + static_cast<gl::GLuint>(sizeof(typename First::Type)), stride);
+    }
+};
+
+
+template <gl::GLuint Index, typename T, typename Conversion>
+void Attr<Index, T, Conversion>::apply(VertexArray * vao, const Buffer * vbo, const gl::GLint baseOffset, const gl::GLuint relativeOffset, const gl::GLint stride)
+{
+    VertexAttributeBinding * binding = vao->binding(Index);
+
+    binding->setAttribute(Index);
+
+    if (std::is_same<Conversion, Native>::value && Traits::integral)
+        binding->setIFormat(Traits::size, Traits::type, relativeOffset);
+    else if (std::is_same<Conversion, Native>::value && Traits::isDouble)
+        binding->setLFormat(Traits::size, Traits::type, relativeOffset);
+    else
+        binding->setFormat(Traits::size, Traits::type, std::is_same<Conversion, Normalized>::value ? gl::GL_TRUE : gl::GL_FALSE, relativeOffset);
+
+    binding->setBuffer(vbo, baseOffset, stride);
+
+    vao->enable(static_cast<gl::GLint>(Index));
+}
+
+template <typename... Attributes>
+gl::GLint VertexLayout<Attributes...>::stride()
+{
+    return VertexLayoutAttributes<Attributes...>::size;
+}
+
+template <typename... Attributes>
+unsigned int VertexLayout<Attributes...>::attributeCount()
+{
+    return VertexLayoutAttributes<Attributes...>::count;
+}
+
+template <typename... Attributes>
+void VertexLayout<Attributes...>::apply(VertexArray * vao, const Buffer * vbo, const gl::GLint baseOffset)
+{
+    VertexLayoutAttributes<Attributes...>::apply(vao, vbo, baseOffset, 0, stride());
+}
+
+template <typename... Attributes>
+template <typename Vertex>
+void VertexLayout<Attributes...>::apply(VertexArray * vao, const Buffer * vbo, const gl::GLint baseOffset)
+{
+    static_assert(sizeof(Vertex) == VertexLayoutAttributes<Attributes...>::size, "The vertex type does not match the layout; attributes have to be declared in member order without padding");
+
+    apply(vao, vbo, baseOffset);
+}
+
+} // namespace globjects
@@ -13,6 +13,16 @@ public:
 
 	virtual void operator()() = 0;
 	virtual void * identifier() const = 0;
+
+	/** \brief Returns a copy of the call, or nullptr if it can not be copied (default).
+		Settings with calls that can not be copied are not shadowed by the state registry.
+	*/
+	virtual AbstractFunctionCall * clone() const;
+
+	/** \brief Returns whether other calls the same function with equal arguments; false by default, i.e., the call is never elided.
+		FunctionCall compares the arguments with operator==, thus pointer arguments by address and not the data they point to.
+	*/
+	virtual bool equals(const AbstractFunctionCall & other) const;
 };
 
 } // namespace globjects
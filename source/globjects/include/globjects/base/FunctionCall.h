@@ -22,6 +22,9 @@ public:
     virtual void operator()() override;
     virtual void * identifier() const override;
 
+    virtual AbstractFunctionCall * clone() const override;
+    virtual bool equals(const AbstractFunctionCall & other) const override;
+
 protected:
     mutable FunctionPointer m_functionPointer;
     std::function<void(Arguments...)> m_function;
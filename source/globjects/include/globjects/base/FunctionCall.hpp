@@ -94,4 +94,20 @@ void * FunctionCall<Arguments...>::identifier() const
     return *reinterpret_cast<void**>(&m_functionPointer);
 }
 
+template <typename... Arguments>
+AbstractFunctionCall * FunctionCall<Arguments...>::clone() const
+{
+    return new FunctionCall<Arguments...>(*this);
+}
+
+template <typename... Arguments>
+bool FunctionCall<Arguments...>::equals(const AbstractFunctionCall & other) const
+{
+    // equal identifiers imply the same function and thereby the same argument types
+    if (identifier() != other.identifier())
+        return false;
+
+    return m_arguments == static_cast<const FunctionCall<Arguments...> &>(other).m_arguments;
+}
+
 } // namespace globjects
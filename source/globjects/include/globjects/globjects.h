@@ -95,6 +95,18 @@ GLOBJECTS_API void disable(gl::GLenum capability, int index);
 GLOBJECTS_API bool isEnabled(gl::GLenum capability, int index);
 GLOBJECTS_API void setEnabled(gl::GLenum capability, int index, bool enabled);
 
+/** \brief Forgets the bindings cached for the current context.
+    Call it after code outside of globjects bound buffers, textures, vertex arrays, framebuffers, or programs.
+*/
+GLOBJECTS_API void invalidateBindings();
+
+/** \brief Deletes the objects released while no context sharing them was current, e.g., from worker threads.
+    Call it at a safe point, e.g., once per frame, with a context of the share group current.
+    Framebuffers, vertex arrays, queries and transform feedbacks are not shared and are deleted only with their creating context current.
+    \return number of deleted objects
+*/
+GLOBJECTS_API unsigned int processDeletionQueue();
+
 GLOBJECTS_API void initializeStrategy(AbstractUniform::BindlessImplementation impl);
 GLOBJECTS_API void initializeStrategy(Buffer::BindlessImplementation impl);
 GLOBJECTS_API void initializeStrategy(Framebuffer::BindlessImplementation impl);
@@ -4,6 +4,7 @@
 #include <glbinding/gl/functions.h>
 #include <glbinding/gl/enum.h>
 
+#include <globjects/StateBlock.h>
 #include <globjects/StateSetting.h>
 
 
@@ -19,12 +20,23 @@ void AbstractState::setEnabled(GLenum capability, const bool enabled)
 
 void AbstractState::setEnabled(GLenum capability, const int index, const bool enabled)
 {
-    enabled ? enable(capability) : disable(capability, index);
+    enabled ? enable(capability, index) : disable(capability, index);
+}
+
+void AbstractState::add(const StateBlock & values)
+{
+    for (const GLenum capability : values.capabilities())
+        setEnabled(capability, values.isEnabled(capability));
+
+    for (StateSetting * setting : values.settings())
+        add(setting);
 }
 
 void AbstractState::blendColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha)
 {
-    add(new StateSetting(glBlendColor, red, green, blue, alpha));
+    StateBlock values;
+    values.blendColor(red, green, blue, alpha);
+    add(values);
 }
 
 void AbstractState::blendColor(const std::array<GLfloat, 4> & color)
@@ -34,17 +46,23 @@ void AbstractState::blendColor(const std::array<GLfloat, 4> & color)
 
 void AbstractState::blendFunc(const GLenum sFactor, const GLenum dFactor)
 {
-    add(new StateSetting(glBlendFunc, sFactor, dFactor));
+    StateBlock values;
+    values.blendFunc(sFactor, dFactor);
+    add(values);
 }
 
 void AbstractState::blendFuncSeparate(const GLenum srcRGB, const GLenum dstRGB, const GLenum srcAlpha, const GLenum dstAlpha)
 {
-    add(new StateSetting(glBlendFuncSeparate, srcRGB, dstRGB, srcAlpha, dstAlpha));
+    StateBlock values;
+    values.blendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    add(values);
 }
 
 void AbstractState::clearColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha)
 {
-    add(new StateSetting(glClearColor, red, green, blue, alpha));
+    StateBlock values;
+    values.clearColor(red, green, blue, alpha);
+    add(values);
 }
 
 void AbstractState::clearColor(const std::array<GLfloat, 4> & color)
@@ -54,17 +72,23 @@ void AbstractState::clearColor(const std::array<GLfloat, 4> & color)
 
 void AbstractState::clearDepth(const GLfloat depth)
 {
-    add(new StateSetting(glClearDepthf, depth));
+    StateBlock values;
+    values.clearDepth(depth);
+    add(values);
 }
 
 void AbstractState::clearStencil(const GLint s)
 {
-    add(new StateSetting(glClearStencil, s));
+    StateBlock values;
+    values.clearStencil(s);
+    add(values);
 }
 
 void AbstractState::colorMask(const GLboolean red, const GLboolean green, const GLboolean blue, const GLboolean alpha)
 {
-    add(new StateSetting(glColorMask, red, green, blue, alpha));
+    StateBlock values;
+    values.colorMask(red, green, blue, alpha);
+    add(values);
 }
 
 void AbstractState::colorMask(const std::array<GLboolean, 4> & mask)
@@ -74,41 +98,54 @@ void AbstractState::colorMask(const std::array<GLboolean, 4> & mask)
 
 void AbstractState::cullFace(const GLenum mode)
 {
-    add(new StateSetting(glCullFace, mode));
+    StateBlock values;
+    values.cullFace(mode);
+    add(values);
 }
 
 void AbstractState::depthFunc(const GLenum func)
 {
-    add(new StateSetting(glDepthFunc, func));
+    StateBlock values;
+    values.depthFunc(func);
+    add(values);
 }
 
 void AbstractState::depthMask(const GLboolean flag)
 {
-    add(new StateSetting(glDepthMask, flag));
+    StateBlock values;
+    values.depthMask(flag);
+    add(values);
 }
 
 void AbstractState::depthRange(const GLdouble nearVal, const GLdouble farVal)
 {
-    add(new StateSetting(glDepthRange, nearVal, farVal));
+    depthRange(static_cast<GLfloat>(nearVal), static_cast<GLfloat>(farVal));
 }
 
 void AbstractState::depthRange(const GLfloat nearVal, const GLfloat farVal)
 {
-    add(new StateSetting(glDepthRangef, nearVal, farVal));
+    StateBlock values;
+    values.depthRange(nearVal, farVal);
+    add(values);
 }
 
 void AbstractState::depthRange(const std::array<GLfloat, 2> & range)
 {
     depthRange(range[0], range[1]);
 }
-    
-    void AbstractState::frontFace(GLenum winding) {
-        add(new StateSetting(glFrontFace, winding));
-    }
+
+void AbstractState::frontFace(const GLenum winding)
+{
+    StateBlock values;
+    values.frontFace(winding);
+    add(values);
+}
 
 void AbstractState::logicOp(const GLenum opcode)
 {
-    add(new StateSetting(glLogicOp, opcode));
+    StateBlock values;
+    values.logicOp(opcode);
+    add(values);
 }
 
 void AbstractState::pixelStore(const GLenum pname, const GLint param)
@@ -127,39 +164,51 @@ void AbstractState::pointParameter(const GLenum pname, const GLint param)
 
 void AbstractState::pointSize(const GLfloat size)
 {
-    add(new StateSetting(glPointSize, size));
+    StateBlock values;
+    values.pointSize(size);
+    add(values);
 }
 
 void AbstractState::polygonMode(const GLenum face, const GLenum mode)
 {
-    auto setting = new StateSetting(glPolygonMode, face, mode);
-    setting->type().specializeType(face);
-    add(setting);
+    StateBlock values;
+    values.polygonMode(face, mode);
+    add(values);
 }
 
 void AbstractState::polygonOffset(const GLfloat factor, const GLfloat units)
 {
-    add(new StateSetting(glPolygonOffset, factor, units));
+    StateBlock values;
+    values.polygonOffset(factor, units);
+    add(values);
 }
 
 void AbstractState::primitiveRestartIndex(const GLuint index)
 {
-    add(new StateSetting(glPrimitiveRestartIndex, index));
+    StateBlock values;
+    values.primitiveRestartIndex(index);
+    add(values);
 }
 
 void AbstractState::provokingVertex(const GLenum provokeMode)
 {
-    add(new StateSetting(glProvokingVertex, provokeMode));
+    StateBlock values;
+    values.provokingVertex(provokeMode);
+    add(values);
 }
 
 void AbstractState::sampleCoverage(const GLfloat value, const GLboolean invert)
 {
-    add(new StateSetting(glSampleCoverage, value, invert));
+    StateBlock values;
+    values.sampleCoverage(value, invert);
+    add(values);
 }
 
 void AbstractState::scissor(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
 {
-    add(new StateSetting(glScissor, x, y, width, height));
+    StateBlock values;
+    values.scissor(x, y, width, height);
+    add(values);
 }
 
 void AbstractState::scissor(const std::array<GLint, 4> & scissorBox)
@@ -169,38 +218,44 @@ void AbstractState::scissor(const std::array<GLint, 4> & scissorBox)
 
 void AbstractState::stencilFunc(const GLenum func, const GLint ref, const GLuint mask)
 {
-    add(new StateSetting(glStencilFunc, func, ref, mask));
+    StateBlock values;
+    values.stencilFuncSeparate(GL_FRONT_AND_BACK, func, ref, mask);
+    add(values);
 }
 
 void AbstractState::stencilMask(const GLuint mask)
 {
-    add(new StateSetting(glStencilMask, mask));
+    StateBlock values;
+    values.stencilMaskSeparate(GL_FRONT_AND_BACK, mask);
+    add(values);
 }
 
 void AbstractState::stencilOp(const GLenum stencilFail, const GLenum depthFail, const GLenum depthPass)
 {
-    add(new StateSetting(glStencilOp, stencilFail, depthFail, depthPass));
+    StateBlock values;
+    values.stencilOpSeparate(GL_FRONT_AND_BACK, stencilFail, depthFail, depthPass);
+    add(values);
 }
 
 void AbstractState::stencilFuncSeparate(const GLenum face, const GLenum func, const GLint ref, const GLuint mask)
 {
-    auto setting = new StateSetting(glStencilFuncSeparate, face, func, ref, mask);
-    setting->type().specializeType(face);
-    add(setting);
+    StateBlock values;
+    values.stencilFuncSeparate(face, func, ref, mask);
+    add(values);
 }
 
 void AbstractState::stencilMaskSeparate(const GLenum face, const GLuint mask)
 {
-    auto setting = new StateSetting(glStencilMaskSeparate, face, mask);
-    setting->type().specializeType(face);
-    add(setting);
+    StateBlock values;
+    values.stencilMaskSeparate(face, mask);
+    add(values);
 }
 
 void AbstractState::stencilOpSeparate(const GLenum face, const GLenum stencilFail, const GLenum depthFail, const GLenum depthPass)
 {
-    auto setting = new StateSetting(glStencilOpSeparate, face, stencilFail, depthFail, depthPass);
-    setting->type().specializeType(face);
-    add(setting);
+    StateBlock values;
+    values.stencilOpSeparate(face, stencilFail, depthFail, depthPass);
+    add(values);
 }
 
 } // namespace globjects
@@ -0,0 +1,243 @@
+#include <globjects/BindlessResidencyManager.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Texture.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+GLint levelParameter(const GLenum target, const GLenum pname)
+{
+    GLint value = 0;
+
+    glGetTexLevelParameteriv(target, 0, pname, &value);
+
+    return value;
+}
+
+}
+
+namespace globjects
+{
+
+BindlessResidencyManager::FrameStatistics::FrameStatistics()
+: madeResident(0)
+, madeNonResident(0)
+{
+}
+
+
+BindlessResidencyManager::BindlessResidencyManager(const unsigned int maxUnusedFrames)
+: m_maxUnusedFrames(maxUnusedFrames)
+, m_memoryBudget(0)
+, m_residentMemory(0)
+, m_frame(0)
+{
+}
+
+BindlessResidencyManager::~BindlessResidencyManager()
+{
+    releaseAll();
+}
+
+unsigned int BindlessResidencyManager::maxUnusedFrames() const
+{
+    return m_maxUnusedFrames;
+}
+
+void BindlessResidencyManager::setMaxUnusedFrames(const unsigned int frames)
+{
+    m_maxUnusedFrames = frames;
+}
+
+GLint64 BindlessResidencyManager::memoryBudget() const
+{
+    return m_memoryBudget;
+}
+
+void BindlessResidencyManager::setMemoryBudget(const GLint64 bytes)
+{
+    m_memoryBudget = bytes;
+
+    evictOverBudget();
+}
+
+TextureHandle BindlessResidencyManager::touch(Texture * texture)
+{
+    assert(texture != nullptr);
+
+    auto it = m_lookup.find(texture);
+    if (it != m_lookup.end())
+        return touch(texture, it->second->size);
+
+    return touch(texture, estimateSize(texture));
+}
+
+TextureHandle BindlessResidencyManager::touch(Texture * texture, const GLint64 sizeInBytes)
+{
+    assert(texture != nullptr);
+
+    auto it = m_lookup.find(texture);
+    if (it != m_lookup.end())
+    {
+        EntryList::iterator entry = it->second;
+
+        entry->lastUsed = m_frame;
+        m_residentMemory += sizeInBytes - entry->size;
+        entry->size = sizeInBytes;
+
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+
+        return entry->handle;
+    }
+
+    Entry entry;
+    entry.texture = texture;
+    entry.handle = texture->makeResident();
+    entry.size = sizeInBytes;
+    entry.lastUsed = m_frame;
+
+    m_entries.push_front(entry);
+    m_lookup[texture] = m_entries.begin();
+
+    m_residentMemory += sizeInBytes;
+    ++m_currentFrame.madeResident;
+
+    evictOverBudget();
+
+    return entry.handle;
+}
+
+void BindlessResidencyManager::release(Texture * texture)
+{
+    auto it = m_lookup.find(texture);
+    if (it == m_lookup.end())
+        return;
+
+    makeNonResident(it->second);
+}
+
+void BindlessResidencyManager::releaseAll()
+{
+    while (!m_entries.empty())
+        makeNonResident(std::prev(m_entries.end()));
+}
+
+void BindlessResidencyManager::nextFrame()
+{
+    while (!m_entries.empty())
+    {
+        EntryList::iterator leastRecentlyUsed = std::prev(m_entries.end());
+
+        if (m_frame - leastRecentlyUsed->lastUsed < m_maxUnusedFrames)
+            break;
+
+        makeNonResident(leastRecentlyUsed);
+    }
+
+    m_lastFrame = m_currentFrame;
+    m_currentFrame = FrameStatistics();
+
+    ++m_frame;
+}
+
+bool BindlessResidencyManager::isResident(const Texture * texture) const
+{
+    return m_lookup.find(texture) != m_lookup.end();
+}
+
+std::size_t BindlessResidencyManager::residentCount() const
+{
+    return m_entries.size();
+}
+
+GLint64 BindlessResidencyManager::residentMemory() const
+{
+    return m_residentMemory;
+}
+
+const BindlessResidencyManager::FrameStatistics & BindlessResidencyManager::currentFrameStatistics() const
+{
+    return m_currentFrame;
+}
+
+const BindlessResidencyManager::FrameStatistics & BindlessResidencyManager::lastFrameStatistics() const
+{
+    return m_lastFrame;
+}
+
+void BindlessResidencyManager::makeNonResident(const EntryList::iterator entry)
+{
+    entry->texture->makeNonResident();
+
+    m_residentMemory -= entry->size;
+    ++m_currentFrame.madeNonResident;
+
+    m_lookup.erase(entry->texture.get());
+    m_entries.erase(entry);
+}
+
+void BindlessResidencyManager::evictOverBudget()
+{
+    if (m_memoryBudget <= 0)
+        return;
+
+    while (m_residentMemory > m_memoryBudget && !m_entries.empty())
+    {
+        EntryList::iterator leastRecentlyUsed = std::prev(m_entries.end());
+
+        // handles touched within this frame may still be referenced by pending draw calls
+        if (leastRecentlyUsed->lastUsed == m_frame)
+            break;
+
+        makeNonResident(leastRecentlyUsed);
+    }
+}
+
+GLint64 BindlessResidencyManager::estimateSize(const Texture * texture)
+{
+    texture->bind();
+
+    const GLenum target = texture->target() == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : texture->target();
+    const GLint64 faces = texture->target() == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+
+    const GLint64 texels = static_cast<GLint64>(levelParameter(target, GL_TEXTURE_WIDTH))
+        * std::max(levelParameter(target, GL_TEXTURE_HEIGHT), 1)
+        * std::max(levelParameter(target, GL_TEXTURE_DEPTH), 1)
+        * std::max(levelParameter(target, GL_TEXTURE_SAMPLES), 1);
+
+    GLint64 size = 0;
+
+    if (levelParameter(target, GL_TEXTURE_COMPRESSED) != 0)
+    {
+        size = levelParameter(target, GL_TEXTURE_COMPRESSED_IMAGE_SIZE);
+    }
+    else
+    {
+        const GLint bits = levelParameter(target, GL_TEXTURE_RED_SIZE)
+            + levelParameter(target, GL_TEXTURE_GREEN_SIZE)
+            + levelParameter(target, GL_TEXTURE_BLUE_SIZE)
+            + levelParameter(target, GL_TEXTURE_ALPHA_SIZE)
+            + levelParameter(target, GL_TEXTURE_DEPTH_SIZE)
+            + levelParameter(target, GL_TEXTURE_STENCIL_SIZE);
+
+        size = texels * ((bits + 7) / 8);
+    }
+
+    // a full mipmap chain adds roughly a third of the base level
+    if (texture->getParameter(GL_TEXTURE_IMMUTABLE_LEVELS) > 1)
+        size += size / 3;
+
+    return size * faces;
+}
+
+} // namespace globjects
@@ -1,5 +1,6 @@
 #include <globjects/Buffer.h>
 
+#include <atomic>
 #include <cassert>
 
 #include <glbinding/gl/functions.h>
@@ -8,6 +9,8 @@
 #include <globjects/globjects.h>
 #include <globjects/ObjectVisitor.h>
 
+#include "registry/BindingRegistry.h"
+#include "registry/DeletionRegistry.h"
 #include "registry/ImplementationRegistry.h"
 
 #include "Resource.h"
@@ -20,6 +23,8 @@ using namespace gl;
 namespace 
 {
 
+std::atomic<unsigned int> s_serials(0);
+
 const globjects::AbstractBufferImplementation & implementation()
 {
     return globjects::ImplementationRegistry::current().bufferImplementation();
@@ -48,6 +53,7 @@ Buffer::Buffer()
 
 Buffer::Buffer(IDResource * resource)
 : Object(resource)
+, m_serial(++s_serials)
 {
 }
 
@@ -58,6 +64,8 @@ Buffer * Buffer::fromId(const GLuint id)
 
 Buffer::~Buffer()
 {
+    if (isContextCurrent())
+        DeletionRegistry::current().forget(DeletionRegistry::Buffers, id());
 }
 
 void Buffer::accept(ObjectVisitor& visitor)
@@ -67,17 +75,20 @@ void Buffer::accept(ObjectVisitor& visitor)
 
 void Buffer::bind(const GLenum target) const
 {
-    glBindBuffer(target, id());
+    if (BindingRegistry::current().bindBuffer(target, id()))
+        glBindBuffer(target, id());
 }
 
 void Buffer::unbind(const GLenum target)
 {
-    glBindBuffer(target, 0);
+    if (BindingRegistry::current().bindBuffer(target, 0))
+        glBindBuffer(target, 0);
 }
 
 void Buffer::unbind(const GLenum target, const GLuint index)
 {
-    glBindBufferBase(target, index, 0);
+    if (BindingRegistry::current().bindBufferBase(target, index, 0))
+        glBindBufferBase(target, index, 0);
 }
 
 const void * Buffer::map() const
@@ -132,12 +143,14 @@ GLint64 Buffer::getParameter64(const GLenum pname) const
 
 void Buffer::bindBase(const GLenum target, const GLuint index) const
 {
-    glBindBufferBase(target, index, id());
+    if (BindingRegistry::current().bindBufferBase(target, index, id()))
+        glBindBufferBase(target, index, id());
 }
 
 void Buffer::bindRange(const GLenum target, const GLuint index, const GLintptr offset, const GLsizeiptr size) const
 {
-    glBindBufferRange(target, index, id(), offset, size);
+    if (BindingRegistry::current().bindBufferRange(target, index, id(), offset, size))
+        glBindBufferRange(target, index, id(), offset, size);
 }
 
 void Buffer::copySubData(Buffer * buffer, const GLintptr readOffset, const GLintptr writeOffset, const GLsizeiptr size) const
@@ -200,4 +213,9 @@ GLenum Buffer::objectType() const
     return GL_BUFFER;
 }
 
+unsigned int Buffer::serial() const
+{
+    return m_serial;
+}
+
 } // namespace globjects
@@ -59,6 +59,11 @@ bool Capability::isEnabled(const int index) const
     return m_indexEnabled.at(index);
 }
 
+const std::map<int, bool> & Capability::indexEnabled() const
+{
+    return m_indexEnabled;
+}
+
 void Capability::apply()
 {
     if (m_indexEnabled.empty())
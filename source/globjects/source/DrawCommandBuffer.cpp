@@ -0,0 +1,203 @@
+#include <globjects/DrawCommandBuffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Buffer.h>
+#include <globjects/VertexArray.h>
+
+
+using namespace gl;
+
+namespace globjects
+{
+
+DrawCommandBuffer::DrawCommandBuffer(const GLenum mode, const GLenum indexType, const GLsizeiptr recordSize)
+: m_mode(mode)
+, m_indexType(indexType)
+, m_commandSize(indexType == GL_NONE ? sizeof(DrawArraysIndirectCommand) : sizeof(DrawElementsIndirectCommand))
+, m_recordSize(recordSize)
+, m_dirty(false)
+, m_commandBuffer(new Buffer())
+, m_recordBuffer(recordSize > 0 ? new Buffer() : nullptr)
+, m_commandCapacity(0)
+, m_recordCapacity(0)
+{
+    assert(recordSize >= 0);
+}
+
+DrawCommandBuffer::~DrawCommandBuffer()
+{
+}
+
+GLenum DrawCommandBuffer::mode() const
+{
+    return m_mode;
+}
+
+GLenum DrawCommandBuffer::indexType() const
+{
+    return m_indexType;
+}
+
+GLsizeiptr DrawCommandBuffer::recordSize() const
+{
+    return m_recordSize;
+}
+
+unsigned int DrawCommandBuffer::add(const DrawArraysIndirectCommand & command, const void * record)
+{
+    assert(m_indexType == GL_NONE);
+
+    return append(&command, sizeof(command), record);
+}
+
+unsigned int DrawCommandBuffer::add(const DrawElementsIndirectCommand & command, const void * record)
+{
+    assert(m_indexType != GL_NONE);
+
+    return append(&command, sizeof(command), record);
+}
+
+void DrawCommandBuffer::setRecord(const unsigned int drawID, const void * record)
+{
+    assert(drawID < size());
+    assert(record != nullptr);
+
+    std::memcpy(m_records.data() + drawID * m_recordSize, record, static_cast<std::size_t>(m_recordSize));
+
+    m_dirty = true;
+}
+
+unsigned int DrawCommandBuffer::size() const
+{
+    return static_cast<unsigned int>(m_commands.size() / m_commandSize);
+}
+
+void DrawCommandBuffer::clear()
+{
+    m_commands.clear();
+    m_records.clear();
+
+    m_dirty = true;
+}
+
+void DrawCommandBuffer::upload()
+{
+    if (!m_dirty)
+        return;
+
+    uploadTo(m_commandBuffer, m_commandCapacity, m_commands);
+
+    if (m_recordBuffer)
+        uploadTo(m_recordBuffer, m_recordCapacity, m_records);
+
+    m_dirty = false;
+}
+
+Buffer * DrawCommandBuffer::commandBuffer() const
+{
+    return m_commandBuffer;
+}
+
+Buffer * DrawCommandBuffer::recordBuffer() const
+{
+    return m_recordBuffer;
+}
+
+void DrawCommandBuffer::bindRecords(const GLuint index)
+{
+    assert(m_recordBuffer != nullptr);
+
+    upload();
+
+    m_recordBuffer->bindBase(GL_SHADER_STORAGE_BUFFER, index);
+}
+
+void DrawCommandBuffer::draw(const VertexArray * vao)
+{
+    assert(vao != nullptr);
+
+    if (m_commands.empty())
+        return;
+
+    upload();
+
+    m_commandBuffer->bind(GL_DRAW_INDIRECT_BUFFER);
+
+    if (m_indexType == GL_NONE)
+        vao->multiDrawArraysIndirect(m_mode, nullptr, static_cast<GLsizei>(size()), 0);
+    else
+        vao->multiDrawElementsIndirect(m_mode, m_indexType, nullptr, static_cast<GLsizei>(size()), 0);
+
+    m_commandBuffer->unbind(GL_DRAW_INDIRECT_BUFFER);
+}
+
+void DrawCommandBuffer::draw(const VertexArray * vao, Buffer * parameterBuffer, const GLintptr offset)
+{
+    assert(vao != nullptr);
+    assert(parameterBuffer != nullptr);
+
+    if (m_commands.empty())
+        return;
+
+    upload();
+
+    m_commandBuffer->bind(GL_DRAW_INDIRECT_BUFFER);
+    parameterBuffer->bind(GL_PARAMETER_BUFFER_ARB);
+
+    // the commands in the buffer bound the count read by the GPU
+    if (m_indexType == GL_NONE)
+        vao->multiDrawArraysIndirectCount(m_mode, nullptr, offset, static_cast<GLsizei>(size()), 0);
+    else
+        vao->multiDrawElementsIndirectCount(m_mode, m_indexType, nullptr, offset, static_cast<GLsizei>(size()), 0);
+
+    parameterBuffer->unbind(GL_PARAMETER_BUFFER_ARB);
+    m_commandBuffer->unbind(GL_DRAW_INDIRECT_BUFFER);
+}
+
+unsigned int DrawCommandBuffer::append(const void * command, const GLsizeiptr commandSize, const void * record)
+{
+    assert(commandSize == m_commandSize);
+    assert(record == nullptr || m_recordSize > 0);
+
+    const unsigned int drawID = size();
+
+    const char * commandBytes = static_cast<const char *>(command);
+    m_commands.insert(m_commands.end(), commandBytes, commandBytes + commandSize);
+
+    if (m_recordSize > 0)
+    {
+        // records not given are zero initialized, to be set with setRecord()
+        m_records.resize(m_records.size() + static_cast<std::size_t>(m_recordSize), 0);
+
+        if (record)
+            std::memcpy(m_records.data() + drawID * m_recordSize, record, static_cast<std::size_t>(m_recordSize));
+    }
+
+    m_dirty = true;
+
+    return drawID;
+}
+
+void DrawCommandBuffer::uploadTo(Buffer * buffer, GLsizeiptr & capacity, const std::vector<char> & data)
+{
+    const GLsizeiptr size = static_cast<GLsizeiptr>(data.size());
+
+    if (size == 0)
+        return;
+
+    // grows geometrically, so rebuilding the commands every frame does not reallocate
+    if (capacity < size)
+    {
+        capacity = std::max(size, capacity * 2);
+        buffer->setData(capacity, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    buffer->setSubData(0, size, data.data());
+}
+
+} // namespace globjects
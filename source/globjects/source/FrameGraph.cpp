@@ -0,0 +1,633 @@
+#include <globjects/FrameGraph.h>
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+#include <glbinding/Meta.h>
+
+#include <globjects/Framebuffer.h>
+#include <globjects/RenderTargetPool.h>
+#include <globjects/Texture.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+bool isColorAttachment(const GLenum attachment)
+{
+    return attachment >= GL_COLOR_ATTACHMENT0 && attachment <= GL_COLOR_ATTACHMENT15;
+}
+
+const char * accessString(const globjects::FrameGraph::Access access)
+{
+    switch (access)
+    {
+    case globjects::FrameGraph::Access::Image:
+        return "image";
+    case globjects::FrameGraph::Access::Attachment:
+        return "attachment";
+    default:
+        return "sampled";
+    }
+}
+
+std::string barrierString(const MemoryBarrierMask barriers)
+{
+    static const std::pair<MemoryBarrierMask, const char *> names[] = {
+        std::make_pair(GL_TEXTURE_FETCH_BARRIER_BIT, "GL_TEXTURE_FETCH_BARRIER_BIT")
+    ,   std::make_pair(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT, "GL_SHADER_IMAGE_ACCESS_BARRIER_BIT")
+    ,   std::make_pair(GL_FRAMEBUFFER_BARRIER_BIT, "GL_FRAMEBUFFER_BARRIER_BIT")
+    };
+
+    std::string result;
+
+    for (const auto & name : names)
+    {
+        if ((static_cast<unsigned int>(barriers) & static_cast<unsigned int>(name.first)) == 0)
+            continue;
+
+        if (!result.empty())
+            result += " | ";
+
+        result += name.second;
+    }
+
+    return result;
+}
+
+MemoryBarrierMask barrierFor(const globjects::FrameGraph::Access access)
+{
+    switch (access)
+    {
+    case globjects::FrameGraph::Access::Image:
+        return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    case globjects::FrameGraph::Access::Attachment:
+        return GL_FRAMEBUFFER_BARRIER_BIT;
+    default:
+        return GL_TEXTURE_FETCH_BARRIER_BIT;
+    }
+}
+
+}
+
+namespace globjects
+{
+
+FrameGraph::TextureDescription::TextureDescription()
+: target(GL_TEXTURE_2D)
+, internalFormat(GL_RGBA8)
+, size(1, 1, 1)
+, samples(0)
+{
+}
+
+FrameGraph::TextureDescription::TextureDescription(const GLenum internalFormat, const glm::ivec2 & size)
+: target(GL_TEXTURE_2D)
+, internalFormat(internalFormat)
+, size(size.x, size.y, 1)
+, samples(0)
+{
+}
+
+FrameGraph::TextureDescription::TextureDescription(const GLenum target, const GLenum internalFormat, const glm::ivec3 & size, const GLsizei samples)
+: target(target)
+, internalFormat(internalFormat)
+, size(size)
+, samples(samples)
+{
+}
+
+bool FrameGraph::TextureDescription::operator==(const TextureDescription & other) const
+{
+    return target == other.target && internalFormat == other.internalFormat && size == other.size && samples == other.samples;
+}
+
+
+FrameGraph::PassBuilder::PassBuilder(FrameGraph & graph, const Handle pass)
+: m_graph(graph)
+, m_pass(pass)
+{
+}
+
+FrameGraph::Handle FrameGraph::PassBuilder::create(const std::string & name, const TextureDescription & description)
+{
+    Resource resource;
+    resource.name = name;
+    resource.description = description;
+    resource.output = false;
+
+    m_graph.m_resources.push_back(resource);
+
+    return static_cast<Handle>(m_graph.m_resources.size() - 1);
+}
+
+void FrameGraph::PassBuilder::read(const Handle resource, const Access access)
+{
+    assert(resource < m_graph.m_resources.size());
+
+    Usage usage;
+    usage.resource = resource;
+    usage.access = access;
+    usage.attachment = GL_NONE;
+
+    m_graph.m_passes[m_pass].reads.push_back(usage);
+    m_graph.m_compiled = false;
+}
+
+void FrameGraph::PassBuilder::write(const Handle resource, const GLenum attachment)
+{
+    assert(resource < m_graph.m_resources.size());
+
+    Usage usage;
+    usage.resource = resource;
+    usage.access = Access::Attachment;
+    usage.attachment = attachment;
+
+    m_graph.m_passes[m_pass].writes.push_back(usage);
+    m_graph.m_compiled = false;
+}
+
+void FrameGraph::PassBuilder::writeImage(const Handle resource)
+{
+    assert(resource < m_graph.m_resources.size());
+
+    Usage usage;
+    usage.resource = resource;
+    usage.access = Access::Image;
+    usage.attachment = GL_NONE;
+
+    m_graph.m_passes[m_pass].writes.push_back(usage);
+    m_graph.m_compiled = false;
+}
+
+void FrameGraph::PassBuilder::setSideEffect()
+{
+    m_graph.m_passes[m_pass].sideEffect = true;
+}
+
+
+FrameGraph::PassResources::PassResources(const FrameGraph & graph, Framebuffer * framebuffer)
+: m_graph(graph)
+, m_framebuffer(framebuffer)
+{
+}
+
+Texture * FrameGraph::PassResources::texture(const Handle resource) const
+{
+    assert(resource < m_graph.m_resources.size());
+
+    const Resource & entry = m_graph.m_resources[resource];
+
+    if (entry.imported)
+        return entry.imported;
+
+    if (entry.physical < 0)
+        return nullptr;
+
+    return m_graph.m_physicalTextures[entry.physical];
+}
+
+Framebuffer * FrameGraph::PassResources::framebuffer() const
+{
+    return m_framebuffer;
+}
+
+
+FrameGraph::FrameGraph()
+: m_compiled(false)
+, m_frame(0)
+, m_pool(new RenderTargetPool(1))
+{
+}
+
+FrameGraph::~FrameGraph()
+{
+}
+
+FrameGraph::Handle FrameGraph::import(const std::string & name, Texture * texture)
+{
+    assert(texture != nullptr);
+
+    Resource resource;
+    resource.name = name;
+    resource.imported = texture;
+    resource.output = true;
+
+    m_resources.push_back(resource);
+    m_compiled = false;
+
+    return static_cast<Handle>(m_resources.size() - 1);
+}
+
+void FrameGraph::markOutput(const Handle resource)
+{
+    assert(resource < m_resources.size());
+
+    m_resources[resource].output = true;
+    m_compiled = false;
+}
+
+void FrameGraph::addPass(const std::string & name, const Setup & setup, const Execute & execute)
+{
+    Pass pass;
+    pass.name = name;
+    pass.execute = execute;
+    pass.sideEffect = false;
+
+    m_passes.push_back(pass);
+    m_compiled = false;
+
+    PassBuilder builder(*this, static_cast<Handle>(m_passes.size() - 1));
+    setup(builder);
+}
+
+void FrameGraph::compile()
+{
+    cull();
+    computeLifetimes();
+    assignPhysicalTextures();
+    computeBarriers();
+
+    m_compiled = true;
+}
+
+void FrameGraph::execute()
+{
+    if (!m_compiled)
+        compile();
+
+    m_physicalTextures.clear();
+
+    for (const TextureDescription & description : m_physicalDescriptions)
+        m_physicalTextures.push_back(m_pool->texture(description.target, description.internalFormat, description.size, description.samples));
+
+    for (Handle i = 0; i < m_passes.size(); ++i)
+    {
+        const Pass & pass = m_passes[i];
+
+        if (pass.culled)
+            continue;
+
+        if (pass.barrier)
+            glMemoryBarrier(pass.barriers);
+
+        Framebuffer * fbo = obtainFramebuffer(pass);
+
+        if (fbo)
+            fbo->bind(GL_FRAMEBUFFER);
+
+        pass.execute(PassResources(*this, fbo));
+
+        if (!fbo)
+            continue;
+
+        // transient attachments ending their lifetime here are never read again
+        std::vector<GLenum> discard;
+
+        for (const Usage & usage : pass.writes)
+        {
+            const Resource & resource = m_resources[usage.resource];
+
+            if (usage.access == Access::Attachment && !resource.imported && !resource.output && resource.lastUse == i)
+                discard.push_back(usage.attachment);
+        }
+
+        fbo->invalidate(discard);
+
+        Framebuffer::unbind(GL_FRAMEBUFFER);
+    }
+
+    m_pool->nextFrame();
+
+    for (auto it = m_framebuffers.begin(); it != m_framebuffers.end(); )
+    {
+        if (it->second.lastUsed < m_frame)
+            it = m_framebuffers.erase(it);
+        else
+            ++it;
+    }
+
+    ++m_frame;
+}
+
+void FrameGraph::reset()
+{
+    m_passes.clear();
+    m_resources.clear();
+    m_physicalDescriptions.clear();
+    m_physicalTextures.clear();
+
+    m_compiled = false;
+}
+
+std::string FrameGraph::dump() const
+{
+    std::stringstream stream;
+
+    const std::size_t culled = std::count_if(m_passes.begin(), m_passes.end(), [](const Pass & pass) { return pass.culled; });
+
+    stream << "FrameGraph: " << m_passes.size() << " passes (" << culled << " culled), "
+        << m_resources.size() << " resources, " << m_physicalDescriptions.size() << " physical textures" << std::endl;
+
+    for (std::size_t i = 0; i < m_passes.size(); ++i)
+    {
+        const Pass & pass = m_passes[i];
+
+        stream << "  pass " << i << " \"" << pass.name << "\"";
+
+        if (pass.culled)
+            stream << " culled";
+        if (pass.sideEffect)
+            stream << " side effect";
+        if (pass.barrier)
+            stream << " barrier " << barrierString(pass.barriers);
+
+        stream << std::endl;
+
+        for (const Usage & usage : pass.reads)
+            stream << "    read  " << m_resources[usage.resource].name << " (" << accessString(usage.access) << ")" << std::endl;
+
+        for (const Usage & usage : pass.writes)
+        {
+            stream << "    write " << m_resources[usage.resource].name << " (";
+
+            if (usage.access == Access::Attachment)
+                stream << glbinding::Meta::getString(usage.attachment);
+            else
+                stream << accessString(usage.access);
+
+            stream << ")" << std::endl;
+        }
+    }
+
+    for (std::size_t i = 0; i < m_resources.size(); ++i)
+    {
+        const Resource & resource = m_resources[i];
+
+        stream << "  resource " << i << " \"" << resource.name << "\"";
+
+        if (resource.imported)
+        {
+            stream << " imported";
+        }
+        else
+        {
+            stream << " " << glbinding::Meta::getString(resource.description.internalFormat)
+                << " " << resource.description.size.x << "x" << resource.description.size.y << "x" << resource.description.size.z;
+
+            if (resource.description.samples > 0)
+                stream << " " << resource.description.samples << " samples";
+        }
+
+        if (resource.output)
+            stream << " output";
+
+        if (!resource.used)
+        {
+            stream << " unused" << std::endl;
+            continue;
+        }
+
+        if (resource.physical >= 0)
+            stream << " texture " << resource.physical;
+
+        stream << " passes " << resource.firstUse << "-" << resource.lastUse << std::endl;
+    }
+
+    return stream.str();
+}
+
+void FrameGraph::cull()
+{
+    for (Resource & resource : m_resources)
+    {
+        resource.writers.clear();
+        resource.refCount = resource.output ? 1 : 0;
+    }
+
+    for (Handle i = 0; i < m_passes.size(); ++i)
+    {
+        Pass & pass = m_passes[i];
+
+        pass.culled = false;
+        pass.refCount = static_cast<unsigned int>(pass.writes.size());
+
+        for (const Usage & usage : pass.reads)
+            ++m_resources[usage.resource].refCount;
+
+        for (const Usage & usage : pass.writes)
+            m_resources[usage.resource].writers.push_back(i);
+    }
+
+    std::vector<Handle> unreferenced;
+
+    const auto cullPass = [this, &unreferenced](Pass & pass)
+    {
+        pass.culled = true;
+
+        for (const Usage & usage : pass.reads)
+        {
+            if (--m_resources[usage.resource].refCount == 0)
+                unreferenced.push_back(usage.resource);
+        }
+    };
+
+    for (Pass & pass : m_passes)
+    {
+        if (pass.refCount == 0 && !pass.sideEffect)
+            cullPass(pass);
+    }
+
+    for (Handle i = 0; i < m_resources.size(); ++i)
+    {
+        if (m_resources[i].refCount == 0)
+            unreferenced.push_back(i);
+    }
+
+    while (!unreferenced.empty())
+    {
+        const Handle resource = unreferenced.back();
+        unreferenced.pop_back();
+
+        for (const Handle writer : m_resources[resource].writers)
+        {
+            Pass & pass = m_passes[writer];
+
+            if (pass.culled || pass.refCount == 0)
+                continue;
+
+            if (--pass.refCount == 0 && !pass.sideEffect)
+                cullPass(pass);
+        }
+    }
+}
+
+void FrameGraph::computeLifetimes()
+{
+    for (Resource & resource : m_resources)
+    {
+        resource.used = false;
+        resource.firstUse = 0;
+        resource.lastUse = 0;
+        resource.physical = -1;
+    }
+
+    for (Handle i = 0; i < m_passes.size(); ++i)
+    {
+        const Pass & pass = m_passes[i];
+
+        if (pass.culled)
+            continue;
+
+        for (const std::vector<Usage> * usages : { &pass.reads, &pass.writes })
+        {
+            for (const Usage & usage : *usages)
+            {
+                Resource & resource = m_resources[usage.resource];
+
+                if (!resource.used)
+                {
+                    resource.used = true;
+                    resource.firstUse = i;
+                }
+
+                resource.lastUse = i;
+            }
+        }
+    }
+}
+
+void FrameGraph::assignPhysicalTextures()
+{
+    m_physicalDescriptions.clear();
+
+    std::vector<Handle> transients;
+
+    for (Handle i = 0; i < m_resources.size(); ++i)
+    {
+        if (m_resources[i].used && !m_resources[i].imported)
+            transients.push_back(i);
+    }
+
+    std::stable_sort(transients.begin(), transients.end(), [this](const Handle a, const Handle b)
+    {
+        return m_resources[a].firstUse < m_resources[b].firstUse;
+    });
+
+    std::vector<Handle> physicalLastUse;
+
+    for (const Handle handle : transients)
+    {
+        Resource & resource = m_resources[handle];
+
+        for (std::size_t p = 0; p < m_physicalDescriptions.size(); ++p)
+        {
+            if (physicalLastUse[p] < resource.firstUse && m_physicalDescriptions[p] == resource.description)
+            {
+                resource.physical = static_cast<int>(p);
+                break;
+            }
+        }
+
+        if (resource.physical < 0)
+        {
+            resource.physical = static_cast<int>(m_physicalDescriptions.size());
+
+            m_physicalDescriptions.push_back(resource.description);
+            physicalLastUse.push_back(resource.lastUse);
+        }
+
+        physicalLastUse[resource.physical] = resource.lastUse;
+    }
+}
+
+void FrameGraph::computeBarriers()
+{
+    // incoherent writes through image stores have to be made visible explicitly, separately for each kind of
+    // access; a barrier makes the stores of all resources visible to the kinds of access it was issued for only
+    const unsigned int imageStore = static_cast<unsigned int>(barrierFor(Access::Sampled))
+        | static_cast<unsigned int>(barrierFor(Access::Image))
+        | static_cast<unsigned int>(barrierFor(Access::Attachment));
+
+    // barrier bits still required by each resource
+    std::vector<unsigned int> outstanding(m_resources.size(), 0u);
+
+    for (Pass & pass : m_passes)
+    {
+        pass.barrier = false;
+        pass.barriers = static_cast<MemoryBarrierMask>(0);
+
+        if (pass.culled)
+            continue;
+
+        unsigned int barriers = 0u;
+
+        for (const std::vector<Usage> * usages : { &pass.reads, &pass.writes })
+        {
+            for (const Usage & usage : *usages)
+                barriers |= outstanding[usage.resource] & static_cast<unsigned int>(barrierFor(usage.access));
+        }
+
+        if (barriers != 0u)
+        {
+            pass.barrier = true;
+            pass.barriers = static_cast<MemoryBarrierMask>(barriers);
+
+            for (unsigned int & bits : outstanding)
+                bits &= ~barriers;
+        }
+
+        for (const Usage & usage : pass.writes)
+            outstanding[usage.resource] = usage.access == Access::Image ? imageStore : 0u;
+    }
+}
+
+Framebuffer * FrameGraph::obtainFramebuffer(const Pass & pass)
+{
+    PassResources resources(*this, nullptr);
+    FramebufferKey key;
+
+    for (const Usage & usage : pass.writes)
+    {
+        if (usage.access == Access::Attachment)
+            key.push_back(std::make_pair(usage.attachment, resources.texture(usage.resource)));
+    }
+
+    if (key.empty())
+        return nullptr;
+
+    std::sort(key.begin(), key.end());
+
+    FramebufferEntry & entry = m_framebuffers[key];
+    entry.lastUsed = m_frame;
+
+    if (entry.framebuffer)
+        return entry.framebuffer;
+
+    entry.framebuffer = new Framebuffer();
+
+    std::vector<GLenum> drawBuffers;
+
+    for (const auto & attachment : key)
+    {
+        entry.framebuffer->attachTexture(attachment.first, const_cast<Texture *>(attachment.second));
+
+        if (isColorAttachment(attachment.first))
+            drawBuffers.push_back(attachment.first);
+    }
+
+    if (drawBuffers.empty())
+        entry.framebuffer->setDrawBuffer(GL_NONE);
+    else
+        entry.framebuffer->setDrawBuffers(drawBuffers);
+
+    return entry.framebuffer;
+}
+
+} // namespace globjects
@@ -5,18 +5,25 @@
 
 #include <glbinding/gl/functions.h>
 #include <glbinding/gl/enum.h>
+#include <glbinding/gl/extension.h>
 #include <glbinding/Meta.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <globjects/globjects.h>
 #include <globjects/ObjectVisitor.h>
 #include <globjects/AttachedTexture.h>
 #include <globjects/FramebufferAttachment.h>
 #include <globjects/AttachedRenderbuffer.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/StateBlock.h>
+#include <globjects/Texture.h>
 #include "pixelformat.h"
 
+#include "registry/BindingRegistry.h"
 #include "registry/ImplementationRegistry.h"
 #include "registry/ObjectRegistry.h"
+#include "registry/StateRegistry.h"
 
 #include "implementations/AbstractFramebufferImplementation.h"
 
@@ -32,6 +39,49 @@ const globjects::AbstractFramebufferImplementation & implementation()
     return globjects::ImplementationRegistry::current().framebufferImplementation();
 }
 
+bool mirroredParameter(const globjects::FramebufferAttachment * attachment, const GLenum pname, GLint & value)
+{
+    if (attachment->isTextureAttachment())
+    {
+        const globjects::AttachedTexture * textureAttachment = attachment->asTextureAttachment();
+
+        switch (pname)
+        {
+        case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE:
+            value = static_cast<GLint>(GL_TEXTURE);
+            return true;
+        case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME:
+            value = static_cast<GLint>(textureAttachment->texture()->id());
+            return true;
+        case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL:
+            value = textureAttachment->level();
+            return true;
+        case GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER:
+            value = textureAttachment->hasLayer() ? textureAttachment->layer() : 0;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    if (attachment->isRenderBufferAttachment())
+    {
+        switch (pname)
+        {
+        case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE:
+            value = static_cast<GLint>(GL_RENDERBUFFER);
+            return true;
+        case GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME:
+            value = static_cast<GLint>(attachment->asRenderBufferAttachment()->renderBuffer()->id());
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
 }
 
 
@@ -46,11 +96,17 @@ void Framebuffer::hintBindlessImplementation(const BindlessImplementation impl)
 
 Framebuffer::Framebuffer()
 : Object(new FrameBufferObjectResource)
+, m_writeCount(0)
+, m_statusValid(false)
+, m_status(GL_NONE)
 {
 }
 
 Framebuffer::Framebuffer(IDResource * resource)
 : Object(resource)
+, m_writeCount(0)
+, m_statusValid(false)
+, m_status(GL_NONE)
 {
 }
 
@@ -66,6 +122,8 @@ Framebuffer * Framebuffer::defaultFBO()
 
 Framebuffer::~Framebuffer()
 {
+    if (isContextCurrent())
+        BindingRegistry::current().forgetFramebuffer(id());
 }
 
 void Framebuffer::accept(ObjectVisitor & visitor)
@@ -75,32 +133,60 @@ void Framebuffer::accept(ObjectVisitor & visitor)
 
 void Framebuffer::bind() const
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, id());
+    bind(GL_FRAMEBUFFER);
 }
 
 void Framebuffer::bind(const GLenum target) const
 {
-    glBindFramebuffer(target, id());
+    if (BindingRegistry::current().bindFramebuffer(target, id()))
+        glBindFramebuffer(target, id());
+
+    if (target != GL_READ_FRAMEBUFFER)
+        ++m_writeCount;
 }
 
 void Framebuffer::unbind()
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    unbind(GL_FRAMEBUFFER);
 }
 
 void Framebuffer::unbind(const GLenum target)
 {
-    glBindFramebuffer(target, 0);
+    if (BindingRegistry::current().bindFramebuffer(target, 0))
+        glBindFramebuffer(target, 0);
 }
 
 void Framebuffer::setParameter(const GLenum pname, const GLint param)
 {
     implementation().setParameter(this, pname, param);
+
+    // default width, height, etc. affect the completeness of framebuffers without attachments
+    m_statusValid = false;
 }
 
 GLint Framebuffer::getAttachmentParameter(const GLenum attachment, const GLenum pname) const
 {
-    return implementation().getAttachmentParameter(this, attachment, pname);
+    const auto attachmentIt = m_attachments.find(attachment);
+
+    // attachments not made through this object, e.g., of the default framebuffer, are not mirrored
+    if (attachmentIt == m_attachments.end() || !attachmentIt->second)
+        return implementation().getAttachmentParameter(this, attachment, pname);
+
+    std::map<GLenum, GLint> & parameters = m_attachmentParameters[attachment];
+
+    const auto it = parameters.find(pname);
+
+    if (it != parameters.end())
+        return it->second;
+
+    GLint value = 0;
+
+    if (!mirroredParameter(attachmentIt->second, pname, value))
+        value = implementation().getAttachmentParameter(this, attachment, pname);
+
+    parameters[pname] = value;
+
+    return value;
 }
 
 void Framebuffer::attachTexture(const GLenum attachment, Texture * texture, const GLint level)
@@ -150,10 +236,40 @@ bool Framebuffer::detach(const GLenum attachment)
     }
 
     m_attachments.erase(attachment);
+    attachmentChanged(attachment);
 
     return true;
 }
 
+void Framebuffer::invalidate(const std::vector<GLenum> & attachments) const
+{
+    if (attachments.empty() || !hasExtension(GLextension::GL_ARB_invalidate_subdata))
+        return;
+
+    implementation().invalidate(this, static_cast<GLsizei>(attachments.size()), attachments.data());
+}
+
+void Framebuffer::invalidate(const std::vector<GLenum> & attachments, const std::array<GLint, 4> & rect) const
+{
+    if (attachments.empty() || !hasExtension(GLextension::GL_ARB_invalidate_subdata))
+        return;
+
+    implementation().invalidateSub(this, static_cast<GLsizei>(attachments.size()), attachments.data(), rect[0], rect[1], rect[2], rect[3]);
+}
+
+void Framebuffer::invalidateTransientAttachments() const
+{
+    std::vector<GLenum> transientAttachments;
+
+    for (const auto & pair : m_attachments)
+    {
+        if (pair.second && pair.second->isTransient())
+            transientAttachments.push_back(pair.first);
+    }
+
+    invalidate(transientAttachments);
+}
+
 void Framebuffer::setReadBuffer(const GLenum mode) const
 {
     implementation().setReadBuffer(this, mode);
@@ -162,6 +278,8 @@ void Framebuffer::setReadBuffer(const GLenum mode) const
 void Framebuffer::setDrawBuffer(const GLenum mode) const
 {
     implementation().setDrawBuffer(this, mode);
+
+    m_statusValid = false;
 }
 
 void Framebuffer::setDrawBuffers(const GLsizei n, const GLenum * modes) const
@@ -169,6 +287,8 @@ void Framebuffer::setDrawBuffers(const GLsizei n, const GLenum * modes) const
     assert(modes != nullptr || n == 0);
 
     implementation().setDrawBuffers(this, n, modes);
+
+    m_statusValid = false;
 }
 
 void Framebuffer::setDrawBuffers(const std::vector<GLenum> & modes) const
@@ -229,6 +349,11 @@ void Framebuffer::clearBuffer(const GLenum buffer, const GLint drawBuffer, const
 void Framebuffer::colorMask(const GLboolean red, const GLboolean green, const GLboolean blue, const GLboolean alpha)
 {
     glColorMask(red, green, blue, alpha);
+
+    StateBlock values;
+    values.colorMask(red, green, blue, alpha);
+
+    StateRegistry::current().block().merge(values);
 }
 
 void Framebuffer::colorMask(const glm::bvec4 & mask)
@@ -239,6 +364,9 @@ void Framebuffer::colorMask(const glm::bvec4 & mask)
 void Framebuffer::colorMaski(const GLuint buffer, const GLboolean red, const GLboolean green, const GLboolean blue, const GLboolean alpha)
 {
     glColorMaski(buffer, red, green, blue, alpha);
+
+    // the color mask of the other draw buffers is unaffected
+    StateRegistry::current().block().unset(1u << StateBlock::ColorMask);
 }
 
 void Framebuffer::colorMaski(const GLuint buffer, const glm::bvec4 & mask)
@@ -249,6 +377,11 @@ void Framebuffer::colorMaski(const GLuint buffer, const glm::bvec4 & mask)
 void Framebuffer::clearColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha)
 {
     glClearColor(red, green, blue, alpha);
+
+    StateBlock values;
+    values.clearColor(red, green, blue, alpha);
+
+    StateRegistry::current().block().merge(values);
 }
 
 void Framebuffer::clearColor(const glm::vec4 & color)
@@ -259,6 +392,11 @@ void Framebuffer::clearColor(const glm::vec4 & color)
 void Framebuffer::clearDepth(const GLclampd depth)
 {
     glClearDepth(depth);
+
+    StateBlock values;
+    values.clearDepth(static_cast<GLfloat>(depth));
+
+    StateRegistry::current().block().merge(values);
 }
 
 void Framebuffer::readPixels(const GLint x, const GLint y, const GLsizei width, const GLsizei height, const GLenum format, const GLenum type, GLvoid * data) const
@@ -331,9 +469,20 @@ void Framebuffer::blit(const std::array<GLint, 4> & srcRect, const std::array<GL
     blit(srcRect[0], srcRect[1], srcRect[2], srcRect[3], destRect[0], destRect[1], destRect[2], destRect[3], mask, filter);
 }
 
+unsigned long long Framebuffer::writeCount() const
+{
+    return m_writeCount;
+}
+
 GLenum Framebuffer::checkStatus() const
 {
-    return implementation().checkStatus(this);
+    if (!m_statusValid)
+    {
+        m_status = implementation().checkStatus(this);
+        m_statusValid = true;
+    }
+
+    return m_status;
 }
 
 std::string Framebuffer::statusString() const
@@ -361,11 +510,26 @@ void Framebuffer::printStatus(bool onlyErrors) const
 	}
 }
 
+void Framebuffer::resetCachedState() const
+{
+    m_attachmentParameters.clear();
+    m_statusValid = false;
+}
+
 void Framebuffer::addAttachment(FramebufferAttachment * attachment)
 {
     assert(attachment != nullptr);
 
     m_attachments[attachment->attachment()] = attachment;
+    attachmentChanged(attachment->attachment());
+}
+
+void Framebuffer::attachmentChanged(const GLenum attachment)
+{
+    m_attachmentParameters.erase(attachment);
+    m_statusValid = false;
+
+    ++m_writeCount;
 }
 
 FramebufferAttachment * Framebuffer::getAttachment(GLenum attachment)
@@ -15,6 +15,7 @@ namespace globjects
 FramebufferAttachment::FramebufferAttachment(Framebuffer * fbo, GLenum attachment)
 : m_fbo(fbo)
 , m_attachment(attachment)
+, m_transient(false)
 {
 }
 
@@ -43,6 +44,16 @@ std::string FramebufferAttachment::attachmentString() const
     return glbinding::Meta::getString(m_attachment);
 }
 
+void FramebufferAttachment::setTransient(const bool transient)
+{
+    m_transient = transient;
+}
+
+bool FramebufferAttachment::isTransient() const
+{
+    return m_transient;
+}
+
 AttachedTexture * FramebufferAttachment::asTextureAttachment()
 {
     return isTextureAttachment() ? reinterpret_cast<AttachedTexture*>(this) : nullptr;
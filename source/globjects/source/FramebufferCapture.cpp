@@ -0,0 +1,153 @@
+#include <globjects/FramebufferCapture.h>
+
+#include <cassert>
+#include <limits>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <globjects/Buffer.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Sync.h>
+
+#include "pixelformat.h"
+
+
+using namespace gl;
+
+namespace globjects
+{
+
+FramebufferCapture::FramebufferCapture(const unsigned int bufferCount)
+: m_slots(bufferCount)
+, m_next(0)
+, m_size(0)
+, m_sizeKey({{ 0, 0, 0, 0 }})
+, m_capturedFrames(0)
+, m_deliveredFrames(0)
+{
+    assert(bufferCount > 0);
+
+    for (Slot & slot : m_slots)
+    {
+        slot.buffer = new Buffer();
+        slot.capacity = 0;
+    }
+}
+
+FramebufferCapture::~FramebufferCapture()
+{
+}
+
+unsigned int FramebufferCapture::bufferCount() const
+{
+    return static_cast<unsigned int>(m_slots.size());
+}
+
+void FramebufferCapture::setCallback(const Callback & callback)
+{
+    m_callback = callback;
+}
+
+void FramebufferCapture::capture(const Framebuffer * fbo, const std::array<GLint, 4> & rect, const GLenum format, const GLenum type)
+{
+    assert(fbo != nullptr);
+
+    Slot & slot = m_slots[m_next];
+
+    // the slot still holds the capture of bufferCount() frames ago
+    if (slot.fence)
+        deliver(slot);
+
+    const GLsizeiptr size = sizeInBytes(rect[2], rect[3], format, type);
+
+    if (slot.capacity < size)
+    {
+        slot.buffer->setData(size, nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+
+    fbo->readPixelsToBuffer(rect, format, type, slot.buffer);
+
+    slot.fence = Sync::fence(GL_SYNC_GPU_COMMANDS_COMPLETE);
+
+    slot.frame.index = m_capturedFrames++;
+    slot.frame.rect = rect;
+    slot.frame.format = format;
+    slot.frame.type = type;
+    slot.frame.data = nullptr;
+    slot.frame.size = size;
+
+    m_next = (m_next + 1) % bufferCount();
+
+    // deliver the oldest capture, which was issued bufferCount() - 1 frames ago
+    Slot & oldest = m_slots[m_next];
+
+    if (oldest.fence && bufferCount() > 1)
+        deliver(oldest);
+}
+
+void FramebufferCapture::capture(const Framebuffer * fbo, const GLenum readBuffer, const std::array<GLint, 4> & rect, const GLenum format, const GLenum type)
+{
+    assert(fbo != nullptr);
+
+    fbo->setReadBuffer(readBuffer);
+
+    capture(fbo, rect, format, type);
+}
+
+void FramebufferCapture::flush()
+{
+    for (unsigned int i = 0; i < bufferCount(); ++i)
+    {
+        Slot & slot = m_slots[(m_next + i) % bufferCount()];
+
+        if (slot.fence)
+            deliver(slot);
+    }
+}
+
+unsigned long long FramebufferCapture::capturedFrames() const
+{
+    return m_capturedFrames;
+}
+
+unsigned long long FramebufferCapture::deliveredFrames() const
+{
+    return m_deliveredFrames;
+}
+
+GLsizeiptr FramebufferCapture::sizeInBytes(const GLsizei width, const GLsizei height, const GLenum format, const GLenum type)
+{
+    const std::array<GLuint, 4> key = {{ static_cast<GLuint>(width), static_cast<GLuint>(height), static_cast<GLuint>(format), static_cast<GLuint>(type) }};
+
+    // queries the pack alignment, thus only once per rect size and format
+    if (key != m_sizeKey)
+    {
+        m_size = imageSizeInBytes(width, height, format, type);
+        m_sizeKey = key;
+    }
+
+    return m_size;
+}
+
+void FramebufferCapture::deliver(Slot & slot)
+{
+    // usually signaled already, as the GPU had several frames to complete the transfer
+    slot.fence->clientWait(GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+    slot.fence = nullptr;
+
+    if (m_callback)
+    {
+        slot.frame.data = slot.buffer->mapRange(0, slot.frame.size, GL_MAP_READ_BIT);
+
+        m_callback(slot.frame);
+
+        slot.buffer->unmap();
+        slot.frame.data = nullptr;
+    }
+
+    ++m_deliveredFrames;
+}
+
+} // namespace globjects
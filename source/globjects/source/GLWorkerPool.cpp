@@ -0,0 +1,221 @@
+#include <globjects/GLWorkerPool.h>
+
+#include <cassert>
+
+#include <glbinding/Binding.h>
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/values.h>
+
+#include <globjects/globjects.h>
+#include <globjects/logging.h>
+#include <globjects/Sync.h>
+
+#include "registry/ExtensionRegistry.h"
+#include "registry/ImplementationRegistry.h"
+#include "registry/Registry.h"
+
+
+using namespace gl;
+
+namespace
+{
+
+// lazily initialized registries are shared with the worker contexts and must not be initialized concurrently
+void initializeSharedRegistries()
+{
+    globjects::ExtensionRegistry::current().availableExtensions();
+
+    globjects::ImplementationRegistry & implementations = globjects::ImplementationRegistry::current();
+
+    implementations.uniformImplementation();
+    implementations.bufferImplementation();
+    implementations.framebufferImplementation();
+    implementations.debugImplementation();
+    implementations.programBinaryImplementation();
+    implementations.shadingLanguageIncludeImplementation();
+    implementations.objectNameImplementation();
+    implementations.attributeImplementation();
+}
+
+}
+
+namespace globjects
+{
+
+GLWorkerPool::GLWorkerPool(const unsigned int workerCount, const CreateContext & createContext, const DestroyContext & destroyContext)
+: m_mainContext(glbinding::getCurrentContext())
+, m_createContext(createContext)
+, m_destroyContext(destroyContext)
+, m_pending(0)
+, m_stop(false)
+, m_startedWorkers(0)
+, m_runningWorkers(0)
+{
+    assert(workerCount > 0);
+    assert(m_createContext);
+
+    initializeSharedRegistries();
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+        m_workers.emplace_back(&GLWorkerPool::run, this, i);
+
+    // tasks submitted without any running worker would never complete
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_started.wait(lock, [this, workerCount]() { return m_startedWorkers == workerCount; });
+
+    if (m_runningWorkers == 0)
+        critical() << "No worker of the pool could create its context, tasks will be rejected";
+}
+
+GLWorkerPool::~GLWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread & worker : m_workers)
+        worker.join();
+}
+
+unsigned int GLWorkerPool::workerCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+unsigned int GLWorkerPool::runningWorkers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_runningWorkers;
+}
+
+bool GLWorkerPool::submit(const Task & task, const Completion & completion)
+{
+    assert(task);
+
+    Job job;
+    job.task = task;
+    job.completion = completion;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_runningWorkers == 0)
+        {
+            critical() << "Task rejected, no worker of the pool is running";
+            return false;
+        }
+
+        m_jobs.push_back(job);
+        ++m_pending;
+    }
+
+    m_condition.notify_one();
+
+    return true;
+}
+
+unsigned int GLWorkerPool::processCompleted()
+{
+    std::vector<Finished> finished;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        finished.swap(m_finished);
+        m_pending -= static_cast<unsigned int>(finished.size());
+    }
+
+    for (Finished & task : finished)
+    {
+        // orders the main context's commands after the task's commands without blocking the client
+        task.sync->wait(GL_TIMEOUT_IGNORED);
+
+        if (task.completion)
+            task.completion();
+    }
+
+    return static_cast<unsigned int>(finished.size());
+}
+
+unsigned int GLWorkerPool::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_pending;
+}
+
+void GLWorkerPool::run(const unsigned int worker)
+{
+    const bool created = m_createContext(worker);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        ++m_startedWorkers;
+
+        if (created)
+            ++m_runningWorkers;
+    }
+
+    m_started.notify_one();
+
+    if (!created)
+    {
+        critical() << "Creating the context of worker " << worker << " failed";
+        return;
+    }
+
+    const glbinding::ContextHandle context = glbinding::getCurrentContext();
+
+    glbinding::Binding::initialize(context, true, false);
+    registerCurrentContext(m_mainContext);
+
+    while (true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_condition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+
+            if (m_stop)
+                break;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        job.task();
+
+        // release everything the task holds here, objects handed over are referenced by the completion
+        job.task = nullptr;
+
+        ref_ptr<Sync> sync = Sync::fence(GL_SYNC_GPU_COMMANDS_COMPLETE);
+
+        // the fence has to be flushed to become visible to the main context
+        glFlush();
+
+        // hand over the last references, so that they are released on the main thread
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_finished.push_back(Finished());
+        m_finished.back().sync = sync;
+        m_finished.back().completion.swap(job.completion);
+
+        sync = nullptr;
+    }
+
+    Registry::deregisterContext(context);
+
+    if (m_destroyContext)
+        m_destroyContext(worker);
+}
+
+} // namespace globjects
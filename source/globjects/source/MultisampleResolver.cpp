@@ -0,0 +1,247 @@
+#include <globjects/MultisampleResolver.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <globjects/logging.h>
+#include <globjects/AttachedRenderbuffer.h>
+#include <globjects/AttachedTexture.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/FramebufferAttachment.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/Texture.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+bool isColorAttachment(const GLenum attachment)
+{
+    return attachment >= GL_COLOR_ATTACHMENT0 && attachment <= GL_COLOR_ATTACHMENT15;
+}
+
+ClearBufferMask resolveMask(const GLenum attachment)
+{
+    switch (attachment)
+    {
+    case GL_DEPTH_ATTACHMENT:
+        return GL_DEPTH_BUFFER_BIT;
+    case GL_STENCIL_ATTACHMENT:
+        return GL_STENCIL_BUFFER_BIT;
+    case GL_DEPTH_STENCIL_ATTACHMENT:
+        return GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+    default:
+        return GL_COLOR_BUFFER_BIT;
+    }
+}
+
+}
+
+namespace globjects
+{
+
+MultisampleResolver::Target::Target()
+: internalFormat(GL_NONE)
+, size(0, 0)
+, writeCount(0)
+, valid(false)
+{
+}
+
+MultisampleResolver::MultisampleResolver(Framebuffer * source)
+: m_source(source)
+, m_target(new Framebuffer())
+, m_resolvedCount(0)
+, m_skippedCount(0)
+{
+    assert(source != nullptr);
+}
+
+MultisampleResolver::~MultisampleResolver()
+{
+}
+
+Framebuffer * MultisampleResolver::source() const
+{
+    return m_source;
+}
+
+Framebuffer * MultisampleResolver::target() const
+{
+    return m_target;
+}
+
+Texture * MultisampleResolver::texture(const GLenum attachment) const
+{
+    const auto it = m_targets.find(attachment);
+
+    return it != m_targets.end() ? it->second.texture.get() : nullptr;
+}
+
+void MultisampleResolver::resolve(const bool depth)
+{
+    std::vector<GLenum> attachments;
+
+    for (FramebufferAttachment * attachment : m_source->attachments())
+    {
+        if (!attachment)
+            continue;
+
+        if (depth || isColorAttachment(attachment->attachment()))
+            attachments.push_back(attachment->attachment());
+    }
+
+    resolve(attachments);
+}
+
+void MultisampleResolver::resolve(const std::vector<GLenum> & attachments)
+{
+    const unsigned long long writeCount = m_source->writeCount();
+
+    std::vector<GLenum> resolved;
+    std::vector<GLenum> colorAttachments;
+    ClearBufferMask depthStencilMask = ClearBufferMask::GL_NONE_BIT;
+    glm::ivec2 size(0, 0);
+
+    for (const GLenum attachment : attachments)
+    {
+        FramebufferAttachment * source = sourceAttachment(attachment);
+
+        if (!source)
+        {
+            warning() << "Cannot resolve " << attachment << ", it is not attached to the source framebuffer";
+            continue;
+        }
+
+        Target & target = m_targets[attachment];
+
+        if (target.valid && target.source == source && target.writeCount == writeCount)
+        {
+            ++m_skippedCount;
+            continue;
+        }
+
+        updateTarget(attachment, target, source);
+        resolved.push_back(attachment);
+
+        if (isColorAttachment(attachment))
+            colorAttachments.push_back(attachment);
+        else
+            depthStencilMask |= resolveMask(attachment);
+
+        // blits are restricted to the area common to all resolved attachments
+        size = size == glm::ivec2(0, 0) ? target.size : glm::ivec2(std::min(size.x, target.size.x), std::min(size.y, target.size.y));
+    }
+
+    if (colorAttachments.empty() && depthStencilMask == ClearBufferMask::GL_NONE_BIT)
+        return;
+
+    const std::array<GLint, 4> rect = {{ 0, 0, size.x, size.y }};
+
+    // depth and stencil ride along with the first color blit
+    ClearBufferMask mask = depthStencilMask;
+    std::size_t i = 0;
+
+    do
+    {
+        if (i < colorAttachments.size())
+        {
+            // read and draw buffer are set before binding, as legacy implementations bind the framebuffers to do so
+            m_source->setReadBuffer(colorAttachments[i]);
+            m_target->setDrawBuffer(colorAttachments[i]);
+
+            mask |= GL_COLOR_BUFFER_BIT;
+        }
+
+        m_source->bind(GL_READ_FRAMEBUFFER);
+        m_target->bind(GL_DRAW_FRAMEBUFFER);
+
+        glBlitFramebuffer(rect[0], rect[1], rect[2], rect[3], rect[0], rect[1], rect[2], rect[3], mask, GL_NEAREST);
+
+        mask = ClearBufferMask::GL_NONE_BIT;
+    }
+    while (++i < colorAttachments.size());
+
+    for (const GLenum attachment : resolved)
+        m_targets[attachment].writeCount = writeCount;
+
+    m_resolvedCount += resolved.size();
+}
+
+void MultisampleResolver::invalidate()
+{
+    for (auto & pair : m_targets)
+        pair.second.valid = false;
+}
+
+unsigned long long MultisampleResolver::resolvedCount() const
+{
+    return m_resolvedCount;
+}
+
+unsigned long long MultisampleResolver::skippedCount() const
+{
+    return m_skippedCount;
+}
+
+FramebufferAttachment * MultisampleResolver::sourceAttachment(const GLenum attachment) const
+{
+    // Framebuffer::getAttachment() would insert an empty entry for unknown attachments
+    for (FramebufferAttachment * candidate : m_source->attachments())
+    {
+        if (candidate && candidate->attachment() == attachment)
+            return candidate;
+    }
+
+    return nullptr;
+}
+
+void MultisampleResolver::updateTarget(const GLenum attachment, Target & target, FramebufferAttachment * source)
+{
+    target.valid = true;
+
+    if (target.source == source)
+        return;
+
+    target.source = source;
+
+    GLenum internalFormat = GL_NONE;
+    glm::ivec2 size(0, 0);
+
+    if (source->isTextureAttachment())
+    {
+        const AttachedTexture * attachedTexture = source->asTextureAttachment();
+
+        internalFormat = static_cast<GLenum>(attachedTexture->texture()->getLevelParameter(attachedTexture->level(), GL_TEXTURE_INTERNAL_FORMAT));
+        size.x = attachedTexture->texture()->getLevelParameter(attachedTexture->level(), GL_TEXTURE_WIDTH);
+        size.y = attachedTexture->texture()->getLevelParameter(attachedTexture->level(), GL_TEXTURE_HEIGHT);
+    }
+    else if (source->isRenderBufferAttachment())
+    {
+        const AttachedRenderbuffer * attachedRenderbuffer = source->asRenderBufferAttachment();
+
+        internalFormat = static_cast<GLenum>(attachedRenderbuffer->renderBuffer()->getParameter(GL_RENDERBUFFER_INTERNAL_FORMAT));
+        size.x = attachedRenderbuffer->renderBuffer()->getParameter(GL_RENDERBUFFER_WIDTH);
+        size.y = attachedRenderbuffer->renderBuffer()->getParameter(GL_RENDERBUFFER_HEIGHT);
+    }
+
+    if (target.texture && target.internalFormat == internalFormat && target.size == size)
+        return;
+
+    target.internalFormat = internalFormat;
+    target.size = size;
+
+    target.texture = new Texture(GL_TEXTURE_2D);
+    target.texture->storage2D(1, internalFormat, size);
+
+    m_target->attachTexture(attachment, target.texture);
+}
+
+} // namespace globjects
@@ -2,6 +2,7 @@
 #include <globjects/Object.h>
 
 #include "registry/ObjectRegistry.h"
+#include "registry/Registry.h"
 #include "registry/ImplementationRegistry.h"
 #include "implementations/AbstractObjectNameImplementation.h"
 
@@ -30,14 +31,20 @@ void Object::hintNameImplementation(const NameImplementation impl)
 
 Object::Object(IDResource * resource)
 : m_resource(resource)
+, m_registry(resource->id() != 0 ? Registry::current().sharedObjects() : nullptr)
 , m_objectLabelState(nullptr)
 {
-    ObjectRegistry::current().registerObject(this);
+    // default objects are not registered, and must not keep the registry holding them alive
+    if (m_registry)
+        m_registry->registerObject(this);
 }
 
 Object::~Object()
 {
-    ObjectRegistry::current().deregisterObject(this);
+    // the registry of the creating context, as the object may be released without any context current
+    if (m_registry)
+        m_registry->deregisterObject(this);
+
     delete m_resource;
 }
 
@@ -51,6 +58,11 @@ bool Object::isDefault() const
     return id() == 0;
 }
 
+bool Object::isContextCurrent() const
+{
+    return m_resource->isContextCurrent();
+}
+
 std::string Object::name() const
 {
     return nameImplementation().getLabel(this);
@@ -71,7 +83,8 @@ void Object::detach()
     if (!m_resource)
         return;
 
-    ObjectRegistry::current().deregisterObject(this);
+    if (m_registry)
+        m_registry->deregisterObject(this);
 
     delete m_resource;
     m_resource = new InvalidResource();
@@ -0,0 +1,218 @@
+#include <globjects/PipelineState.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#include <globjects/Framebuffer.h>
+#include <globjects/Program.h>
+#include <globjects/State.h>
+#include <globjects/VertexArray.h>
+
+#include "registry/StateRegistry.h"
+
+
+namespace
+{
+
+// relative switch costs, roughly following the cost of the driver's validation
+const unsigned int s_framebufferCost = 100;
+const unsigned int s_programCost = 50;
+const unsigned int s_vertexArrayCost = 10;
+const unsigned int s_stateValueCost = 2;
+
+std::atomic<unsigned long long> s_nextSerial(1);
+
+void combine(std::size_t & hash, const std::size_t value)
+{
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+}
+
+namespace globjects
+{
+
+PipelineState::PipelineState(Program * program, VertexArray * vao, const StateBlock & state, Framebuffer * framebuffer)
+: m_serial(s_nextSerial++)
+, m_program(program)
+, m_vertexArray(vao)
+, m_framebuffer(framebuffer)
+, m_state(state)
+, m_hash(0)
+, m_cost(0)
+{
+    assert(program != nullptr);
+
+    computeHash();
+
+    m_cost = s_programCost + m_state.count() * s_stateValueCost;
+
+    if (m_vertexArray)
+        m_cost += s_vertexArrayCost;
+
+    if (m_framebuffer)
+        m_cost += s_framebufferCost;
+}
+
+PipelineState::PipelineState(Program * program, VertexArray * vao, const State * state, Framebuffer * framebuffer)
+: PipelineState(program, vao, state ? state->block() : StateBlock(), framebuffer)
+{
+}
+
+PipelineState::~PipelineState()
+{
+}
+
+Program * PipelineState::program() const
+{
+    return m_program;
+}
+
+VertexArray * PipelineState::vertexArray() const
+{
+    return m_vertexArray;
+}
+
+Framebuffer * PipelineState::framebuffer() const
+{
+    return m_framebuffer;
+}
+
+const StateBlock & PipelineState::state() const
+{
+    return m_state;
+}
+
+std::size_t PipelineState::hash() const
+{
+    return m_hash;
+}
+
+bool PipelineState::operator==(const PipelineState & other) const
+{
+    return m_hash == other.m_hash
+        && m_program == other.m_program
+        && m_vertexArray == other.m_vertexArray
+        && m_framebuffer == other.m_framebuffer
+        && m_state == other.m_state;
+}
+
+bool PipelineState::operator!=(const PipelineState & other) const
+{
+    return !(*this == other);
+}
+
+void PipelineState::computeHash()
+{
+    m_hash = m_state.hash();
+
+    combine(m_hash, std::hash<const void *>()(m_program.get()));
+    combine(m_hash, std::hash<const void *>()(m_vertexArray.get()));
+    combine(m_hash, std::hash<const void *>()(m_framebuffer.get()));
+}
+
+void PipelineState::apply() const
+{
+    if (m_framebuffer)
+        m_framebuffer->bind();
+
+    m_program->use();
+
+    if (m_vertexArray)
+        m_vertexArray->bind();
+
+    StateRegistry & shadow = StateRegistry::current();
+
+    // values left behind by others are reset, as by a transition
+    const StateBlock state = m_state.completed(shadow.block());
+    const unsigned int issued = state.applyDiff(shadow.block());
+
+    shadow.block().merge(state);
+    shadow.countIssued(issued);
+    shadow.countElided(state.count() - issued);
+}
+
+void PipelineState::apply(const PipelineState * from) const
+{
+    if (!from)
+    {
+        apply();
+        return;
+    }
+
+    const Transition & transition = this->transition(*from);
+
+    if (transition.framebuffer)
+        m_framebuffer->bind();
+
+    if (transition.program)
+        m_program->use();
+
+    if (transition.vertexArray)
+        m_vertexArray->bind();
+
+    transition.state.apply();
+
+    // from is current, so the context has all values of this pipeline state and the reset ones of from now
+    StateRegistry & shadow = StateRegistry::current();
+
+    shadow.block().merge(m_state);
+    shadow.block().merge(transition.state);
+    shadow.countIssued(transition.state.count());
+    shadow.countElided(transition.valueCount - transition.state.count());
+}
+
+unsigned int PipelineState::switchCost(const PipelineState * from) const
+{
+    if (!from)
+        return m_cost;
+
+    return transition(*from).cost;
+}
+
+const PipelineState::Transition & PipelineState::transition(const PipelineState & from) const
+{
+    // serials instead of pointers, as a deleted predecessor's address may be reused
+    auto it = std::find_if(m_transitions.begin(), m_transitions.end(), [&from](const Transition & transition)
+    {
+        return transition.from == from.m_serial;
+    });
+
+    if (it != m_transitions.end())
+    {
+        std::rotate(m_transitions.begin(), it, it + 1);
+
+        return m_transitions.front();
+    }
+
+    Transition transition;
+    transition.from = from.m_serial;
+    transition.program = m_program != from.m_program;
+    transition.vertexArray = m_vertexArray && m_vertexArray != from.m_vertexArray;
+    transition.framebuffer = m_framebuffer && m_framebuffer != from.m_framebuffer;
+
+    const StateBlock state = m_state.completed(from.m_state);
+    transition.state = state.difference(from.m_state);
+    transition.valueCount = state.count();
+
+    transition.cost = transition.state.count() * s_stateValueCost;
+
+    if (transition.program)
+        transition.cost += s_programCost;
+
+    if (transition.vertexArray)
+        transition.cost += s_vertexArrayCost;
+
+    if (transition.framebuffer)
+        transition.cost += s_framebufferCost;
+
+    if (m_transitions.size() >= TransitionCacheSize)
+        m_transitions.pop_back();
+
+    m_transitions.insert(m_transitions.begin(), transition);
+
+    return m_transitions.front();
+}
+
+} // namespace globjects
@@ -17,6 +17,8 @@
 #include <globjects/AbstractUniform.h>
 
 #include "Resource.h"
+#include "registry/BindingRegistry.h"
+#include "registry/DeletionRegistry.h"
 #include "registry/ImplementationRegistry.h"
 #include "implementations/AbstractProgramBinaryImplementation.h"
 
@@ -57,10 +59,16 @@ Program::Program(ProgramBinary * binary)
 
 Program::~Program()
 {
+    const bool contextCurrent = isContextCurrent();
+
+    if (contextCurrent)
+        DeletionRegistry::current().forget(DeletionRegistry::Programs, id());
+
     for (std::pair<LocationIdentity, ref_ptr<AbstractUniform>> uniformPair : m_uniforms)
         uniformPair.second->deregisterProgram(this);
 
-    if (0 == id())
+    // deleting the program detaches its shaders, thus deferred deletion does not need to detach
+    if (0 == id() || !contextCurrent)
     {
         for (auto & shader : m_shaders)
             shader->deregisterListener(this);
@@ -84,7 +92,8 @@ void Program::use() const
     if (!isLinked())
         return;
 
-    glUseProgram(id());
+    if (BindingRegistry::current().useProgram(id()))
+        glUseProgram(id());
 }
 
 void Program::release() const
@@ -92,12 +101,22 @@ void Program::release() const
     if (!isLinked())
         return;
 
-    glUseProgram(0);
+    if (BindingRegistry::current().useProgram(0))
+        glUseProgram(0);
 }
 
 bool Program::isUsed() const
 {
-    GLuint currentProgram = static_cast<GLuint>(getInteger(GL_CURRENT_PROGRAM));
+    BindingRegistry & bindings = BindingRegistry::current();
+
+    GLuint currentProgram = 0;
+
+    // query only if the program was not set through globjects since the last invalidateBindings()
+    if (!bindings.usedProgram(currentProgram))
+    {
+        currentProgram = static_cast<GLuint>(getInteger(GL_CURRENT_PROGRAM));
+        bindings.useProgram(currentProgram);
+    }
 
     return currentProgram > 0 && currentProgram == id();
 }
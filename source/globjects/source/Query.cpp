@@ -7,6 +7,7 @@
 #include <globjects/ObjectVisitor.h>
 
 #include "Resource.h"
+#include "registry/NameRegistry.h"
 
 
 using namespace gl;
@@ -61,11 +62,7 @@ int Query::getCounterBits(const GLenum target)
 
 GLuint Query::genQuery()
 {
-	GLuint id;
-
-    glGenQueries(1, &id);
-
-	return id;
+    return NameRegistry::generate(NameRegistry::Queries);
 }
 
 GLint Query::get(const GLenum target, const GLenum pname)
@@ -0,0 +1,406 @@
+#include <globjects/RenderQueue.h>
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Program.h>
+#include <globjects/State.h>
+#include <globjects/Texture.h>
+#include <globjects/VertexArray.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+using Key = std::uint64_t;
+
+// bit layout of the sort key, from most to least significant
+const unsigned int s_programBits = 12;
+const unsigned int s_stateBits = 10;
+const unsigned int s_textureSetBits = 14;
+const unsigned int s_vertexArrayBits = 12;
+const unsigned int s_depthBits = 16;
+
+const unsigned int s_vertexArrayShift = s_depthBits;
+const unsigned int s_textureSetShift = s_vertexArrayShift + s_vertexArrayBits;
+const unsigned int s_stateShift = s_textureSetShift + s_textureSetBits;
+const unsigned int s_programShift = s_stateShift + s_stateBits;
+
+Key field(const unsigned int value, const unsigned int bits, const unsigned int shift)
+{
+    return (static_cast<Key>(value) & ((Key(1) << bits) - 1)) << shift;
+}
+
+// blocks until count threads have called wait(), then releases all of them; reusable
+class Barrier
+{
+public:
+    explicit Barrier(const unsigned int count)
+    : m_count(count)
+    , m_waiting(0)
+    , m_generation(0)
+    {
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        const unsigned long long generation = m_generation;
+
+        if (++m_waiting == m_count)
+        {
+            m_waiting = 0;
+            ++m_generation;
+            m_released.notify_all();
+
+            return;
+        }
+
+        m_released.wait(lock, [this, generation]() { return m_generation != generation; });
+    }
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+
+    const unsigned int m_count;
+    unsigned int m_waiting;
+    unsigned long long m_generation;
+};
+
+// stable LSD radix sort of keys and values, 8 bits per pass; each chunk is histogrammed and scattered by its own thread,
+// which is started once and passes all digits in lockstep with the others
+void radixSort(std::vector<Key> & keys, std::vector<unsigned int> & values, const unsigned int chunkCount)
+{
+    const std::size_t size = keys.size();
+
+    std::vector<Key> sortedKeys(size);
+    std::vector<unsigned int> sortedValues(size);
+    std::vector<std::array<std::size_t, 256>> histograms(chunkCount);
+
+    Barrier barrier(chunkCount);
+
+    // returns whether the result is in the sorted buffers, which is the same for all chunks
+    const auto sortChunk = [&](const unsigned int chunk)
+    {
+        const std::size_t begin = size * chunk / chunkCount;
+        const std::size_t end = size * (chunk + 1) / chunkCount;
+
+        Key * sourceKeys = keys.data();
+        Key * destinationKeys = sortedKeys.data();
+        unsigned int * sourceValues = values.data();
+        unsigned int * destinationValues = sortedValues.data();
+
+        std::array<std::size_t, 256> & histogram = histograms[chunk];
+        std::array<std::size_t, 256> offsets;
+
+        bool swapped = false;
+
+        for (unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            histogram.fill(0);
+
+            for (std::size_t i = begin; i < end; ++i)
+                ++histogram[(sourceKeys[i] >> shift) & 0xff];
+
+            barrier.wait();
+
+            // scatter offsets of this chunk, ordered by digit and then by chunk
+            std::size_t offset = 0;
+            bool trivial = false;
+
+            for (unsigned int digit = 0; digit < 256; ++digit)
+            {
+                const std::size_t first = offset;
+
+                for (unsigned int other = 0; other < chunkCount; ++other)
+                {
+                    if (other == chunk)
+                        offsets[digit] = offset;
+
+                    offset += histograms[other][digit];
+                }
+
+                trivial |= offset - first == size;
+            }
+
+            // unless all keys share this digit, which is common for the upper id bits
+            if (!trivial)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const std::size_t destination = offsets[(sourceKeys[i] >> shift) & 0xff]++;
+
+                    destinationKeys[destination] = sourceKeys[i];
+                    destinationValues[destination] = sourceValues[i];
+                }
+
+                std::swap(sourceKeys, destinationKeys);
+                std::swap(sourceValues, destinationValues);
+                swapped = !swapped;
+            }
+
+            // the next pass reads the scattered keys and overwrites the histograms read above
+            barrier.wait();
+        }
+
+        return swapped;
+    };
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int chunk = 1; chunk < chunkCount; ++chunk)
+        threads.emplace_back(sortChunk, chunk);
+
+    const bool swapped = sortChunk(0);
+
+    for (std::thread & thread : threads)
+        thread.join();
+
+    if (swapped)
+    {
+        keys.swap(sortedKeys);
+        values.swap(sortedValues);
+    }
+}
+
+}
+
+namespace globjects
+{
+
+RenderQueue::DrawParameters::DrawParameters()
+: mode(GL_TRIANGLES)
+, type(GL_NONE)
+, first(0)
+, count(0)
+, indices(nullptr)
+, instanceCount(1)
+, baseVertex(0)
+{
+}
+
+RenderQueue::DrawParameters RenderQueue::DrawParameters::arrays(const GLenum mode, const GLint first, const GLsizei count, const GLsizei instanceCount)
+{
+    DrawParameters parameters;
+    parameters.mode = mode;
+    parameters.first = first;
+    parameters.count = count;
+    parameters.instanceCount = instanceCount;
+
+    return parameters;
+}
+
+RenderQueue::DrawParameters RenderQueue::DrawParameters::elements(const GLenum mode, const GLsizei count, const GLenum type, const void * indices, const GLsizei instanceCount, const GLint baseVertex)
+{
+    DrawParameters parameters;
+    parameters.mode = mode;
+    parameters.type = type;
+    parameters.count = count;
+    parameters.indices = indices;
+    parameters.instanceCount = instanceCount;
+    parameters.baseVertex = baseVertex;
+
+    return parameters;
+}
+
+RenderQueue::Item::Item()
+: program(nullptr)
+, vao(nullptr)
+, state(nullptr)
+, depth(0.0f)
+{
+    textures.fill(nullptr);
+}
+
+RenderQueue::RenderQueue()
+: m_parallelThreshold(16384)
+, m_statistics()
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+void RenderQueue::submit(const Item & item)
+{
+    assert(item.program != nullptr);
+    assert(item.vao != nullptr);
+
+    m_keys.push_back(sortKey(item));
+    m_order.push_back(static_cast<unsigned int>(m_items.size()));
+    m_items.push_back(item);
+}
+
+unsigned int RenderQueue::size() const
+{
+    return static_cast<unsigned int>(m_items.size());
+}
+
+void RenderQueue::clear()
+{
+    m_items.clear();
+    m_keys.clear();
+    m_order.clear();
+
+    m_programIds.clear();
+    m_stateIds.clear();
+    m_vertexArrayIds.clear();
+    m_textureSetIds.clear();
+}
+
+void RenderQueue::flush()
+{
+    m_statistics = Statistics();
+    m_statistics.items = size();
+
+    if (!m_items.empty())
+    {
+        sort();
+        submitSorted();
+    }
+
+    clear();
+}
+
+const RenderQueue::Statistics & RenderQueue::statistics() const
+{
+    return m_statistics;
+}
+
+void RenderQueue::setParallelThreshold(const unsigned int threshold)
+{
+    m_parallelThreshold = threshold;
+}
+
+RenderQueue::Key RenderQueue::sortKey(const Item & item)
+{
+    const float depth = std::min(std::max(item.depth, 0.0f), 1.0f);
+
+    return field(compactId(m_programIds, item.program), s_programBits, s_programShift)
+        | field(compactId(m_stateIds, item.state), s_stateBits, s_stateShift)
+        | field(textureSetId(item), s_textureSetBits, s_textureSetShift)
+        | field(compactId(m_vertexArrayIds, item.vao), s_vertexArrayBits, s_vertexArrayShift)
+        | field(static_cast<unsigned int>(depth * ((1u << s_depthBits) - 1)), s_depthBits, 0);
+}
+
+unsigned int RenderQueue::compactId(std::unordered_map<const void *, unsigned int> & ids, const void * object)
+{
+    // ids are assigned in order of first submission, so the sort roughly keeps the submission order of state
+    return ids.emplace(object, static_cast<unsigned int>(ids.size())).first->second;
+}
+
+unsigned int RenderQueue::textureSetId(const Item & item)
+{
+    std::size_t hash = 0;
+
+    for (const Texture * texture : item.textures)
+        hash = hash * 31 + std::hash<const Texture *>()(texture);
+
+    return m_textureSetIds.emplace(hash, static_cast<unsigned int>(m_textureSetIds.size())).first->second;
+}
+
+void RenderQueue::sort()
+{
+    const unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    sort(m_items.size() >= m_parallelThreshold ? threads : 1);
+}
+
+void RenderQueue::sort(const unsigned int chunkCount)
+{
+    assert(chunkCount > 0);
+
+    radixSort(m_keys, m_order, chunkCount);
+}
+
+void RenderQueue::submitSorted()
+{
+    const Program * program = nullptr;
+    const State * state = nullptr;
+    const VertexArray * vao = nullptr;
+
+    std::array<const Texture *, MaxTextures> textures;
+    textures.fill(nullptr);
+
+    for (const unsigned int index : m_order)
+    {
+        const Item & item = m_items[index];
+
+        if (item.program != program)
+        {
+            item.program->use();
+            program = item.program;
+            ++m_statistics.programChanges;
+        }
+        else
+        {
+            ++m_statistics.elided;
+        }
+
+        if (item.state)
+        {
+            if (item.state != state)
+            {
+                item.state->apply();
+                state = item.state;
+                ++m_statistics.stateChanges;
+            }
+            else
+            {
+                ++m_statistics.elided;
+            }
+        }
+
+        for (unsigned int unit = 0; unit < MaxTextures; ++unit)
+        {
+            if (!item.textures[unit])
+                continue;
+
+            if (item.textures[unit] != textures[unit])
+            {
+                item.textures[unit]->bindActive(static_cast<GLenum>(static_cast<unsigned int>(GL_TEXTURE0) + unit));
+                textures[unit] = item.textures[unit];
+                ++m_statistics.textureChanges;
+            }
+            else
+            {
+                ++m_statistics.elided;
+            }
+        }
+
+        if (item.vao != vao)
+        {
+            item.vao->bind();
+            vao = item.vao;
+            ++m_statistics.vertexArrayChanges;
+        }
+        else
+        {
+            ++m_statistics.elided;
+        }
+
+        if (item.prepare)
+            item.prepare();
+
+        // the vertex array is bound already, its draw functions would bind it again
+        const DrawParameters & draw = item.draw;
+
+        if (draw.type == GL_NONE)
+            glDrawArraysInstanced(draw.mode, draw.first, draw.count, draw.instanceCount);
+        else
+            glDrawElementsInstancedBaseVertex(draw.mode, draw.count, draw.type, draw.indices, draw.instanceCount, draw.baseVertex);
+    }
+}
+
+} // namespace globjects
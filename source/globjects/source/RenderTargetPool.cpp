@@ -0,0 +1,440 @@
+#include <globjects/RenderTargetPool.h>
+
+#include <cassert>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/Texture.h>
+#include <globjects/Renderbuffer.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+bool isMultisample(const GLenum target)
+{
+    return target == GL_TEXTURE_2D_MULTISAMPLE || target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+}
+
+bool isLayered(const GLenum target)
+{
+    return target == GL_TEXTURE_1D_ARRAY || target == GL_TEXTURE_2D_ARRAY
+        || target == GL_TEXTURE_CUBE_MAP_ARRAY || target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+}
+
+void setDefaultParameters(globjects::Texture * texture)
+{
+    // sampler state is not allowed on multisample targets
+    if (isMultisample(texture->target()))
+        return;
+
+    texture->setParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    texture->setParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture->setParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    texture->setParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    texture->setParameter(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+}
+
+}
+
+namespace globjects
+{
+
+RenderTargetPool::FrameStatistics::FrameStatistics()
+: created(0)
+, reused(0)
+, aliased(0)
+, deleted(0)
+{
+}
+
+
+bool RenderTargetPool::Key::operator==(const Key & other) const
+{
+    return internalFormat == other.internalFormat && hasSameExtent(other);
+}
+
+bool RenderTargetPool::Key::hasSameExtent(const Key & other) const
+{
+    return target == other.target && size == other.size && samples == other.samples;
+}
+
+
+RenderTargetPool::RenderTargetPool(const unsigned int maxUnusedFrames)
+: m_maxUnusedFrames(maxUnusedFrames)
+, m_frame(0)
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+}
+
+unsigned int RenderTargetPool::maxUnusedFrames() const
+{
+    return m_maxUnusedFrames;
+}
+
+void RenderTargetPool::setMaxUnusedFrames(const unsigned int frames)
+{
+    m_maxUnusedFrames = frames;
+}
+
+Texture * RenderTargetPool::texture(const GLenum target, const GLenum internalFormat, const glm::ivec3 & size, const GLsizei samples)
+{
+    Key key;
+    key.target = target;
+    key.internalFormat = internalFormat;
+    key.size = glm::ivec3(size.x, size.y, isLayered(target) || target == GL_TEXTURE_3D ? size.z : 1);
+    key.samples = isMultisample(target) ? samples : 0;
+
+    assert(key.size.x > 0 && key.size.y > 0 && key.size.z > 0);
+
+    // exact match
+    for (TextureAllocation & allocation : m_textures)
+    {
+        if (allocation.inUse == nullptr && allocation.key == key)
+        {
+            ++m_currentFrame.reused;
+            return acquire(allocation, allocation.texture);
+        }
+    }
+
+    const unsigned int formatClass = key.samples == 0 ? viewClass(internalFormat) : 0;
+
+    if (formatClass != 0)
+    {
+        // view of the requested format that was created previously
+        for (TextureAllocation & allocation : m_textures)
+        {
+            if (allocation.inUse != nullptr || !allocation.key.hasSameExtent(key))
+                continue;
+
+            if (Texture * view = findView(allocation, internalFormat))
+            {
+                ++m_currentFrame.reused;
+                return acquire(allocation, view);
+            }
+        }
+
+        // alias the storage of a compatible format
+        for (TextureAllocation & allocation : m_textures)
+        {
+            if (allocation.inUse != nullptr || !allocation.key.hasSameExtent(key))
+                continue;
+
+            if (viewClass(allocation.key.internalFormat) != formatClass)
+                continue;
+
+            ++m_currentFrame.aliased;
+            return acquire(allocation, createView(allocation, internalFormat));
+        }
+    }
+
+    TextureAllocation allocation;
+    allocation.key = key;
+    allocation.texture = createTexture(key);
+    allocation.inUse = nullptr;
+    allocation.lastUsed = m_frame;
+
+    m_textures.push_back(allocation);
+    ++m_currentFrame.created;
+
+    return acquire(m_textures.back(), m_textures.back().texture);
+}
+
+Texture * RenderTargetPool::texture2D(const GLenum internalFormat, const glm::ivec2 & size)
+{
+    return texture(GL_TEXTURE_2D, internalFormat, glm::ivec3(size, 1));
+}
+
+Renderbuffer * RenderTargetPool::renderbuffer(const GLenum internalFormat, const glm::ivec2 & size, const GLsizei samples)
+{
+    Key key;
+    key.target = GL_RENDERBUFFER;
+    key.internalFormat = internalFormat;
+    key.size = glm::ivec3(size, 1);
+    key.samples = samples;
+
+    for (RenderbufferAllocation & allocation : m_renderbuffers)
+    {
+        if (!allocation.inUse && allocation.key == key)
+        {
+            allocation.inUse = true;
+            allocation.lastUsed = m_frame;
+
+            ++m_currentFrame.reused;
+
+            return allocation.renderbuffer;
+        }
+    }
+
+    RenderbufferAllocation allocation;
+    allocation.key = key;
+    allocation.renderbuffer = new Renderbuffer();
+    allocation.inUse = true;
+    allocation.lastUsed = m_frame;
+
+    if (samples > 0)
+        allocation.renderbuffer->storageMultisample(samples, internalFormat, size.x, size.y);
+    else
+        allocation.renderbuffer->storage(internalFormat, size.x, size.y);
+
+    m_renderbuffers.push_back(allocation);
+    ++m_currentFrame.created;
+
+    return allocation.renderbuffer;
+}
+
+void RenderTargetPool::release(Texture * texture)
+{
+    for (TextureAllocation & allocation : m_textures)
+    {
+        if (allocation.inUse == texture)
+        {
+            allocation.inUse = nullptr;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::release(Renderbuffer * renderbuffer)
+{
+    for (RenderbufferAllocation & allocation : m_renderbuffers)
+    {
+        if (allocation.renderbuffer == renderbuffer)
+        {
+            allocation.inUse = false;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::nextFrame()
+{
+    for (TextureAllocation & allocation : m_textures)
+        allocation.inUse = nullptr;
+
+    for (RenderbufferAllocation & allocation : m_renderbuffers)
+        allocation.inUse = false;
+
+    for (auto it = m_textures.begin(); it != m_textures.end(); )
+    {
+        if (m_frame - it->lastUsed >= m_maxUnusedFrames)
+        {
+            it = m_textures.erase(it);
+            ++m_currentFrame.deleted;
+        }
+        else
+            ++it;
+    }
+
+    for (auto it = m_renderbuffers.begin(); it != m_renderbuffers.end(); )
+    {
+        if (m_frame - it->lastUsed >= m_maxUnusedFrames)
+        {
+            it = m_renderbuffers.erase(it);
+            ++m_currentFrame.deleted;
+        }
+        else
+            ++it;
+    }
+
+    m_lastFrame = m_currentFrame;
+    m_currentFrame = FrameStatistics();
+
+    ++m_frame;
+}
+
+void RenderTargetPool::clear()
+{
+    for (auto it = m_textures.begin(); it != m_textures.end(); )
+    {
+        if (it->inUse == nullptr)
+        {
+            it = m_textures.erase(it);
+            ++m_currentFrame.deleted;
+        }
+        else
+            ++it;
+    }
+
+    for (auto it = m_renderbuffers.begin(); it != m_renderbuffers.end(); )
+    {
+        if (!it->inUse)
+        {
+            it = m_renderbuffers.erase(it);
+            ++m_currentFrame.deleted;
+        }
+        else
+            ++it;
+    }
+}
+
+const RenderTargetPool::FrameStatistics & RenderTargetPool::currentFrameStatistics() const
+{
+    return m_currentFrame;
+}
+
+const RenderTargetPool::FrameStatistics & RenderTargetPool::lastFrameStatistics() const
+{
+    return m_lastFrame;
+}
+
+unsigned int RenderTargetPool::viewClass(const GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_RGBA32F:
+    case GL_RGBA32UI:
+    case GL_RGBA32I:
+        return 128;
+
+    case GL_RGB32F:
+    case GL_RGB32UI:
+    case GL_RGB32I:
+        return 96;
+
+    case GL_RGBA16F:
+    case GL_RG32F:
+    case GL_RGBA16UI:
+    case GL_RG32UI:
+    case GL_RGBA16I:
+    case GL_RG32I:
+    case GL_RGBA16:
+    case GL_RGBA16_SNORM:
+        return 64;
+
+    case GL_RGB16:
+    case GL_RGB16_SNORM:
+    case GL_RGB16F:
+    case GL_RGB16UI:
+    case GL_RGB16I:
+        return 48;
+
+    case GL_RG16F:
+    case GL_R11F_G11F_B10F:
+    case GL_R32F:
+    case GL_RGB10_A2UI:
+    case GL_RGBA8UI:
+    case GL_RG16UI:
+    case GL_R32UI:
+    case GL_RGBA8I:
+    case GL_RG16I:
+    case GL_R32I:
+    case GL_RGB10_A2:
+    case GL_RGBA8:
+    case GL_RG16:
+    case GL_RGBA8_SNORM:
+    case GL_RG16_SNORM:
+    case GL_SRGB8_ALPHA8:
+    case GL_RGB9_E5:
+        return 32;
+
+    case GL_RGB8:
+    case GL_RGB8_SNORM:
+    case GL_SRGB8:
+    case GL_RGB8UI:
+    case GL_RGB8I:
+        return 24;
+
+    case GL_R16F:
+    case GL_RG8UI:
+    case GL_R16UI:
+    case GL_RG8I:
+    case GL_R16I:
+    case GL_RG8:
+    case GL_R16:
+    case GL_RG8_SNORM:
+    case GL_R16_SNORM:
+        return 16;
+
+    case GL_R8UI:
+    case GL_R8I:
+    case GL_R8:
+    case GL_R8_SNORM:
+        return 8;
+
+    default:
+        return 0;
+    }
+}
+
+Texture * RenderTargetPool::acquire(TextureAllocation & allocation, Texture * texture)
+{
+    allocation.inUse = texture;
+    allocation.lastUsed = m_frame;
+
+    return texture;
+}
+
+Texture * RenderTargetPool::findView(TextureAllocation & allocation, const GLenum internalFormat) const
+{
+    for (const auto & view : allocation.views)
+    {
+        if (view.first == internalFormat)
+            return view.second;
+    }
+
+    return nullptr;
+}
+
+Texture * RenderTargetPool::createView(TextureAllocation & allocation, const GLenum internalFormat)
+{
+    // the view's name must not have been bound before, thus parameters are set afterwards
+    Texture * view = new Texture(allocation.key.target);
+    view->textureView(allocation.texture->id(), internalFormat, 0, 1, 0, layerCount(allocation.key));
+
+    setDefaultParameters(view);
+
+    allocation.views.push_back(std::make_pair(internalFormat, ref_ptr<Texture>(view)));
+
+    return view;
+}
+
+Texture * RenderTargetPool::createTexture(const Key & key)
+{
+    Texture * texture = new Texture(key.target);
+
+    switch (key.target)
+    {
+    case GL_TEXTURE_2D_MULTISAMPLE:
+        texture->image2DMultisample(key.samples, key.internalFormat, glm::ivec2(key.size.x, key.size.y), GL_TRUE);
+        break;
+
+    case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+        texture->image3DMultisample(key.samples, key.internalFormat, key.size, GL_TRUE);
+        break;
+
+    case GL_TEXTURE_2D_ARRAY:
+    case GL_TEXTURE_CUBE_MAP_ARRAY:
+    case GL_TEXTURE_3D:
+        texture->storage3D(1, key.internalFormat, key.size);
+        break;
+
+    default:
+        // immutable storage is required for aliasing via texture views
+        texture->storage2D(1, key.internalFormat, glm::ivec2(key.size.x, key.size.y));
+        break;
+    }
+
+    setDefaultParameters(texture);
+
+    return texture;
+}
+
+GLuint RenderTargetPool::layerCount(const Key & key)
+{
+    if (key.target == GL_TEXTURE_CUBE_MAP)
+        return 6;
+
+    if (isLayered(key.target))
+        return static_cast<GLuint>(key.size.z);
+
+    return 1;
+}
+
+} // namespace globjects
@@ -3,6 +3,8 @@
 #include <glbinding/gl/functions.h>
 
 #include "registry/ImplementationRegistry.h"
+#include "registry/NameRegistry.h"
+#include "registry/Registry.h"
 
 #include "implementations/AbstractBufferImplementation.h"
 #include "implementations/AbstractFramebufferImplementation.h"
@@ -13,14 +15,6 @@ using namespace gl;
 namespace 
 {
 
-template <typename CreateObjectsFunction>
-GLuint createObject(CreateObjectsFunction function)
-{
-    GLuint id;
-    function(1, &id);
-    return id;
-}
-
 template <typename DeleteObjectsFunction>
 void deleteObject(DeleteObjectsFunction function, const GLuint id, const bool hasOwnership)
 {
@@ -68,15 +62,39 @@ GLuint IDTrait::id() const
 IDResource::IDResource(const GLuint id)
 : AbstractResource(true)
 , IDTrait(id)
+, m_deletions(Registry::hasCurrent() ? Registry::current().sharedDeletions() : nullptr)
 {
 }
 
 IDResource::IDResource(const GLuint id, const bool hasOwnership)
 : AbstractResource(hasOwnership)
 , IDTrait(id)
+, m_deletions(Registry::hasCurrent() ? Registry::current().sharedDeletions() : nullptr)
+{
+}
+
+IDResource::IDResource(const GLuint id, const std::shared_ptr<DeletionRegistry> & deletions)
+: AbstractResource(true)
+, IDTrait(id)
+, m_deletions(deletions)
 {
 }
 
+bool IDResource::isContextCurrent() const
+{
+    return m_deletions ? m_deletions->isCurrent() : Registry::hasCurrent();
+}
+
+bool IDResource::deferDeletion(const DeletionRegistry::Type type) const
+{
+    if (!hasOwnership() || !m_deletions || m_deletions->isCurrent())
+        return false;
+
+    m_deletions->enqueue(type, id());
+
+    return true;
+}
+
 
 ExternalResource::ExternalResource(const GLuint id)
 : IDResource(id, false)
@@ -101,19 +119,19 @@ BufferResource::BufferResource()
 
 BufferResource::~BufferResource()
 {
-    if (hasOwnership())
+    if (hasOwnership() && !deferDeletion(DeletionRegistry::Buffers))
         ImplementationRegistry::current().bufferImplementation().destroy(id());
 }
 
 
 FrameBufferObjectResource::FrameBufferObjectResource()
-: IDResource(ImplementationRegistry::current().framebufferImplementation().create())
+: IDResource(ImplementationRegistry::current().framebufferImplementation().create(), Registry::current().sharedContainerDeletions())
 {
 }
 
 FrameBufferObjectResource::~FrameBufferObjectResource()
 {
-    if (hasOwnership())
+    if (hasOwnership() && !deferDeletion(DeletionRegistry::Framebuffers))
         ImplementationRegistry::current().framebufferImplementation().destroy(id());
 }
 
@@ -125,7 +143,7 @@ ProgramResource::ProgramResource()
 
 ProgramResource::~ProgramResource()
 {
-    if (hasOwnership())
+    if (hasOwnership() && !deferDeletion(DeletionRegistry::Programs))
     {
         glDeleteProgram(id());
     }
@@ -133,35 +151,38 @@ ProgramResource::~ProgramResource()
 
 
 QueryResource::QueryResource()
-: IDResource(createObject(glGenQueries))
+: IDResource(NameRegistry::generate(NameRegistry::Queries), Registry::current().sharedContainerDeletions())
 {
 }
 
 QueryResource::~QueryResource()
 {
-    deleteObject(glDeleteQueries, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::Queries))
+        deleteObject(glDeleteQueries, id(), hasOwnership());
 }
 
 
 RenderBufferObjectResource::RenderBufferObjectResource()
-: IDResource(createObject(glGenRenderbuffers))
+: IDResource(NameRegistry::generate(NameRegistry::Renderbuffers))
 {
 }
 
 RenderBufferObjectResource::~RenderBufferObjectResource()
 {
-    deleteObject(glDeleteRenderbuffers, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::Renderbuffers))
+        deleteObject(glDeleteRenderbuffers, id(), hasOwnership());
 }
 
 
 SamplerResource::SamplerResource()
-: IDResource(createObject(glGenSamplers))
+: IDResource(NameRegistry::generate(NameRegistry::Samplers))
 {
 }
 
 SamplerResource::~SamplerResource()
 {
-    deleteObject(glDeleteSamplers, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::Samplers))
+        deleteObject(glDeleteSamplers, id(), hasOwnership());
 }
 
 ShaderResource::ShaderResource(GLenum type)
@@ -171,7 +192,7 @@ ShaderResource::ShaderResource(GLenum type)
 
 ShaderResource::~ShaderResource()
 {
-    if (hasOwnership())
+    if (hasOwnership() && !deferDeletion(DeletionRegistry::Shaders))
     {
         glDeleteShader(id());
     }
@@ -179,35 +200,38 @@ ShaderResource::~ShaderResource()
 
 
 TextureResource::TextureResource()
-: IDResource(createObject(glGenTextures))
+: IDResource(NameRegistry::generate(NameRegistry::Textures))
 {
 }
 
 TextureResource::~TextureResource()
 {
-    deleteObject(glDeleteTextures, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::Textures))
+        deleteObject(glDeleteTextures, id(), hasOwnership());
 }
 
 
 TransformFeedbackResource::TransformFeedbackResource()
-: IDResource(createObject(glGenTransformFeedbacks))
+: IDResource(NameRegistry::generate(NameRegistry::TransformFeedbacks), Registry::current().sharedContainerDeletions())
 {
 }
 
 TransformFeedbackResource::~TransformFeedbackResource()
 {
-    deleteObject(glDeleteTransformFeedbacks, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::TransformFeedbacks))
+        deleteObject(glDeleteTransformFeedbacks, id(), hasOwnership());
 }
 
 
 VertexArrayObjectResource::VertexArrayObjectResource()
-: IDResource(createObject(glGenVertexArrays))
+: IDResource(NameRegistry::generate(NameRegistry::VertexArrays), Registry::current().sharedContainerDeletions())
 {
 }
 
 VertexArrayObjectResource::~VertexArrayObjectResource()
 {
-    deleteObject(glDeleteVertexArrays, id(), hasOwnership());
+    if (!deferDeletion(DeletionRegistry::VertexArrays))
+        deleteObject(glDeleteVertexArrays, id(), hasOwnership());
 }
 
 } // namespace globjects
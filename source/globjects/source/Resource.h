@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include <glbinding/gl/types.h>
 
+#include "registry/DeletionRegistry.h"
+
 namespace globjects 
 {
 
@@ -36,8 +40,26 @@ class IDResource : public AbstractResource, public IDTrait
 public:
     IDResource(gl::GLuint id);
 
+    /** \brief Returns whether a context of the share group the resource was created in is current on the calling thread.
+
+        For container objects, which are not shared, whether the creating context is current.
+    */
+    bool isContextCurrent() const;
+
 protected:
     IDResource(gl::GLuint id, bool hasOwnership);
+
+    /** \brief Creates an owning resource whose deletion is deferred to deletions, e.g., the context's registry for container objects.
+    */
+    IDResource(gl::GLuint id, const std::shared_ptr<DeletionRegistry> & deletions);
+
+    /** \brief Queues the owned name for deletion if no context of its share group, or the creating context for container objects, is current.
+        \return true if the name was queued
+    */
+    bool deferDeletion(DeletionRegistry::Type type) const;
+
+protected:
+    std::shared_ptr<DeletionRegistry> m_deletions;
 };
 
 
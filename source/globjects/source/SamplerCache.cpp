@@ -0,0 +1,199 @@
+#include <globjects/SamplerCache.h>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Sampler.h>
+
+
+using namespace gl;
+
+namespace
+{
+
+template <typename T>
+void hashCombine(std::size_t & seed, const T & value)
+{
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void hashCombine(std::size_t & seed, const GLenum value)
+{
+    hashCombine(seed, static_cast<unsigned int>(value));
+}
+
+}
+
+namespace globjects
+{
+
+SamplerDescription::SamplerDescription()
+: minFilter(GL_NEAREST_MIPMAP_LINEAR)
+, magFilter(GL_LINEAR)
+, wrapS(GL_REPEAT)
+, wrapT(GL_REPEAT)
+, wrapR(GL_REPEAT)
+, minLod(-1000.0f)
+, maxLod(1000.0f)
+, lodBias(0.0f)
+, maxAnisotropy(1.0f)
+, compareMode(GL_NONE)
+, compareFunc(GL_LEQUAL)
+{
+    for (GLfloat & component : borderColor)
+        component = 0.0f;
+}
+
+SamplerDescription::SamplerDescription(const GLenum minFilter, const GLenum magFilter, const GLenum wrap, const GLfloat maxAnisotropy)
+: SamplerDescription()
+{
+    this->minFilter = minFilter;
+    this->magFilter = magFilter;
+    this->wrapS = wrap;
+    this->wrapT = wrap;
+    this->wrapR = wrap;
+    this->maxAnisotropy = maxAnisotropy;
+}
+
+bool SamplerDescription::operator==(const SamplerDescription & other) const
+{
+    return minFilter == other.minFilter
+        && magFilter == other.magFilter
+        && wrapS == other.wrapS
+        && wrapT == other.wrapT
+        && wrapR == other.wrapR
+        && minLod == other.minLod
+        && maxLod == other.maxLod
+        && lodBias == other.lodBias
+        && maxAnisotropy == other.maxAnisotropy
+        && compareMode == other.compareMode
+        && compareFunc == other.compareFunc
+        && borderColor[0] == other.borderColor[0]
+        && borderColor[1] == other.borderColor[1]
+        && borderColor[2] == other.borderColor[2]
+        && borderColor[3] == other.borderColor[3];
+}
+
+bool SamplerDescription::operator!=(const SamplerDescription & other) const
+{
+    return !(*this == other);
+}
+
+std::size_t SamplerDescription::hash() const
+{
+    std::size_t seed = 0;
+
+    hashCombine(seed, minFilter);
+    hashCombine(seed, magFilter);
+    hashCombine(seed, wrapS);
+    hashCombine(seed, wrapT);
+    hashCombine(seed, wrapR);
+    hashCombine(seed, minLod);
+    hashCombine(seed, maxLod);
+    hashCombine(seed, lodBias);
+    hashCombine(seed, maxAnisotropy);
+    hashCombine(seed, compareMode);
+    hashCombine(seed, compareFunc);
+
+    for (const GLfloat component : borderColor)
+        hashCombine(seed, component);
+
+    return seed;
+}
+
+
+SamplerCache::SamplerCache()
+{
+}
+
+SamplerCache::~SamplerCache()
+{
+}
+
+const Sampler * SamplerCache::sampler(const SamplerDescription & description)
+{
+    auto it = m_samplers.find(description);
+    if (it != m_samplers.end())
+        return it->second;
+
+    Sampler * sampler = createSampler(description);
+
+    m_samplers.emplace(description, ref_ptr<Sampler>(sampler));
+
+    return sampler;
+}
+
+std::size_t SamplerCache::size() const
+{
+    return m_samplers.size();
+}
+
+void SamplerCache::removeUnused()
+{
+    for (auto it = m_samplers.begin(); it != m_samplers.end(); )
+    {
+        if (it->second->refCounter() == 1)
+            it = m_samplers.erase(it);
+        else
+            ++it;
+    }
+}
+
+void SamplerCache::clear()
+{
+    m_samplers.clear();
+}
+
+Sampler * SamplerCache::createSampler(const SamplerDescription & description)
+{
+    const SamplerDescription defaults;
+
+    Sampler * sampler = new Sampler();
+
+    // parameters matching the initial state are skipped
+    if (description.minFilter != defaults.minFilter)
+        sampler->setParameter(GL_TEXTURE_MIN_FILTER, description.minFilter);
+    if (description.magFilter != defaults.magFilter)
+        sampler->setParameter(GL_TEXTURE_MAG_FILTER, description.magFilter);
+    if (description.wrapS != defaults.wrapS)
+        sampler->setParameter(GL_TEXTURE_WRAP_S, description.wrapS);
+    if (description.wrapT != defaults.wrapT)
+        sampler->setParameter(GL_TEXTURE_WRAP_T, description.wrapT);
+    if (description.wrapR != defaults.wrapR)
+        sampler->setParameter(GL_TEXTURE_WRAP_R, description.wrapR);
+    if (description.minLod != defaults.minLod)
+        sampler->setParameter(GL_TEXTURE_MIN_LOD, description.minLod);
+    if (description.maxLod != defaults.maxLod)
+        sampler->setParameter(GL_TEXTURE_MAX_LOD, description.maxLod);
+    if (description.lodBias != defaults.lodBias)
+        sampler->setParameter(GL_TEXTURE_LOD_BIAS, description.lodBias);
+    if (description.maxAnisotropy != defaults.maxAnisotropy)
+        sampler->setParameter(GL_TEXTURE_MAX_ANISOTROPY_EXT, description.maxAnisotropy);
+    if (description.compareMode != defaults.compareMode)
+        sampler->setParameter(GL_TEXTURE_COMPARE_MODE, description.compareMode);
+    if (description.compareFunc != defaults.compareFunc)
+        sampler->setParameter(GL_TEXTURE_COMPARE_FUNC, description.compareFunc);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        if (description.borderColor[i] == defaults.borderColor[i])
+            continue;
+
+        glSamplerParameterfv(sampler->id(), GL_TEXTURE_BORDER_COLOR, description.borderColor);
+        break;
+    }
+
+    return sampler;
+}
+
+} // namespace globjects
+
+namespace std
+{
+
+size_t hash<globjects::SamplerDescription>::operator()(const globjects::SamplerDescription & description) const
+{
+    return description.hash();
+}
+
+} // namespace std
@@ -3,12 +3,73 @@
 #include <glbinding/gl/enum.h>
 #include <glbinding/gl/extension.h>
 
+#include <globjects/base/ref_ptr.h>
+
 #include <globjects/globjects.h>
 #include <globjects/Capability.h>
 #include <globjects/StateSetting.h>
 
+#include "registry/StateRegistry.h"
+
 using namespace gl;
 
+namespace
+{
+
+void applyChanged(const globjects::Capability & capability, globjects::StateRegistry & shadow)
+{
+    // globjects::setEnabled updates the shadow
+    if (capability.indexEnabled().empty())
+    {
+        if (shadow.isCurrent(capability.capability(), capability.isEnabled()))
+        {
+            shadow.countElided();
+            return;
+        }
+
+        globjects::setEnabled(capability.capability(), capability.isEnabled());
+        shadow.countIssued();
+
+        return;
+    }
+
+    for (const auto & index : capability.indexEnabled())
+    {
+        if (shadow.isCurrent(capability.capability(), index.first, index.second))
+        {
+            shadow.countElided();
+            continue;
+        }
+
+        globjects::setEnabled(capability.capability(), index.first, index.second);
+        shadow.countIssued();
+    }
+}
+
+void applyChanged(const globjects::StateBlock & values, globjects::StateRegistry & shadow)
+{
+    const unsigned int issued = values.applyDiff(shadow.block());
+
+    shadow.block().merge(values);
+    shadow.countIssued(issued);
+    shadow.countElided(values.count() - issued);
+}
+
+void applyChanged(globjects::StateSetting & setting, globjects::StateRegistry & shadow)
+{
+    if (shadow.isCurrent(setting))
+    {
+        shadow.countElided();
+        return;
+    }
+
+    setting.apply();
+    shadow.setCurrent(setting);
+    shadow.countIssued();
+}
+
+}
+
 namespace globjects 
 {
 
@@ -17,6 +78,12 @@ State::State(const Mode mode)
 {
 }
 
+State::State(const StateBlock & block)
+: m_mode(DeferredMode)
+, m_block(block)
+{
+}
+
 State::~State()
 {
     for (const auto & capability : m_capabilities)
@@ -30,6 +97,73 @@ State::~State()
 }
 
 State * State::currentState()
+{
+    if (isTracking())
+        return trackedState();
+
+    return queriedState();
+}
+
+void State::setTracking(const bool enabled)
+{
+    StateRegistry & shadow = StateRegistry::current();
+
+    if (enabled && !shadow.isTracking())
+        resync();
+
+    shadow.setTracking(enabled);
+}
+
+bool State::isTracking()
+{
+    return StateRegistry::current().isTracking();
+}
+
+void State::resync()
+{
+    StateRegistry & shadow = StateRegistry::current();
+
+    ref_ptr<State> state = queriedState();
+
+    shadow.invalidate();
+    shadow.block() = state->m_block;
+
+    for (const Capability * capability : state->capabilities())
+    {
+        shadow.setCurrent(capability->capability(), capability->isEnabled());
+    }
+    for (const StateSetting * setting : state->settings())
+    {
+        shadow.setCurrent(*setting);
+    }
+}
+
+State * State::trackedState()
+{
+    const StateRegistry & shadow = StateRegistry::current();
+
+    State * state = new State(shadow.block());
+
+    for (const auto & capability : shadow.capabilities())
+    {
+        state->setEnabled(capability.first, capability.second);
+    }
+    for (const auto & capability : shadow.indexedCapabilities())
+    {
+        for (const auto & index : capability.second)
+        {
+            index.second ? state->enable(capability.first, index.first) : state->disable(capability.first, index.first);
+        }
+    }
+    for (const auto & setting : shadow.settings())
+    {
+        state->add(setting.second->clone());
+    }
+
+    return state;
+}
+
+State * State::queriedState()
 {
     State * state = new State(DeferredMode);
 
@@ -99,6 +233,7 @@ State * State::currentState()
     state->colorMask(getBooleans<4>(GL_COLOR_WRITEMASK));
     state->cullFace(getEnum(GL_CULL_FACE_MODE));
     state->depthFunc(getEnum(GL_DEPTH_FUNC));
+    state->depthMask(getBoolean(GL_DEPTH_WRITEMASK));
     state->depthRange(getFloats<2>(GL_DEPTH_RANGE));
     state->frontFace(getEnum(GL_FRONT_FACE));
     state->logicOp(getEnum(GL_LOGIC_OP_MODE));
@@ -144,24 +279,60 @@ State * State::currentState()
     return state;
 }
 
+State::Statistics State::statistics()
+{
+    const StateRegistry & shadow = StateRegistry::current();
+
+    Statistics statistics;
+    statistics.issued = shadow.issued();
+    statistics.elided = shadow.elided();
+
+    return statistics;
+}
+
+void State::resetStatistics()
+{
+    StateRegistry::current().resetCounts();
+}
+
+void State::invalidateShadow()
+{
+    StateRegistry::current().invalidate();
+}
+
 void State::enable(const GLenum capability)
 {
+    if (StateBlock::isStandardCapability(capability))
+    {
+        setCapability(capability, true);
+        return;
+    }
+
     Capability* cap = getCapability(capability);
     cap->enable();
     if (m_mode == ImmediateMode)
-        cap->apply();
+        applyChanged(*cap, StateRegistry::current());
 }
 
 void State::disable(const GLenum capability)
 {
+    if (StateBlock::isStandardCapability(capability))
+    {
+        setCapability(capability, false);
+        return;
+    }
+
     Capability* cap = getCapability(capability);
     cap->disable();
     if (m_mode == ImmediateMode)
-        cap->apply();
+        applyChanged(*cap, StateRegistry::current());
 }
 
 bool State::isEnabled(const GLenum capability) const
 {
+    if (m_block.isSet(capability))
+        return m_block.isEnabled(capability);
+
     if (m_capabilities.find(capability) == m_capabilities.end())
         return false;
 
@@ -169,19 +340,25 @@ bool State::isEnabled(const GLenum capability) const
 }
 
 void State::enable(const GLenum capability, const int index)
-{   
+{
+    // indexed values are kept per index, overriding the capability as a whole
+    m_block.unsetCapability(capability);
+
     Capability* cap = getCapability(capability);
     cap->enable(index);
     if (m_mode == ImmediateMode)
-        cap->apply();
+        applyChanged(*cap, StateRegistry::current());
 }
 
 void State::disable(const GLenum capability, const int index)
 {
+    // indexed values are kept per index, overriding the capability as a whole
+    m_block.unsetCapability(capability);
+
     Capability* cap = getCapability(capability);
     cap->disable(index);
     if (m_mode == ImmediateMode)
-        cap->apply();
+        applyChanged(*cap, StateRegistry::current());
 }
 
 bool State::isEnabled(const GLenum capability, const int index) const
@@ -204,16 +381,98 @@ State::Mode State::mode() const
 
 void State::apply()
 {
+    StateRegistry & shadow = StateRegistry::current();
+
+    applyChanged(m_block, shadow);
+
     for (const auto & capability : m_capabilities)
     {
-        capability.second->apply();
+        applyChanged(*capability.second, shadow);
     }
     for (const auto & setting : m_settings)
     {
+        applyChanged(*setting.second, shadow);
+    }
+}
+
+void State::applyDiff(const State & from)
+{
+    StateRegistry & shadow = StateRegistry::current();
+
+    const unsigned int issued = m_block.applyDiff(from.m_block);
+
+    // from is current, so the context has all standard values of this state now
+    shadow.block().merge(m_block);
+    shadow.countIssued(issued);
+    shadow.countElided(m_block.count() - issued);
+
+    for (const auto & capability : m_capabilities)
+    {
+        const Capability * previous = from.capability(capability.first);
+        const std::map<int, bool> & indices = capability.second->indexEnabled();
+
+        if (indices.empty())
+        {
+            if (previous && previous->indexEnabled().empty() && previous->isEnabled() == capability.second->isEnabled())
+            {
+                shadow.countElided();
+                continue;
+            }
+
+            // the free function issues the call and updates the shadow, the member would modify this state
+            globjects::setEnabled(capability.first, capability.second->isEnabled());
+            shadow.countIssued();
+
+            continue;
+        }
+
+        for (const auto & index : indices)
+        {
+            if (previous)
+            {
+                auto it = previous->indexEnabled().find(index.first);
+                if (it != previous->indexEnabled().end() && it->second == index.second)
+                {
+                    shadow.countElided();
+                    continue;
+                }
+            }
+
+            globjects::setEnabled(capability.first, index.first, index.second);
+            shadow.countIssued();
+        }
+    }
+
+    for (const auto & setting : m_settings)
+    {
+        const StateSetting * previous = from.setting(setting.first);
+        if (previous && previous->equals(*setting.second))
+        {
+            shadow.countElided();
+            continue;
+        }
+
         setting.second->apply();
+        shadow.setCurrent(*setting.second);
+        shadow.countIssued();
     }
 }
 
+void State::setCapability(const GLenum capability, const bool enabled)
+{
+    auto it = m_capabilities.find(capability);
+    if (it != m_capabilities.end())
+    {
+        delete it->second;
+        m_capabilities.erase(it);
+    }
+
+    StateBlock values;
+    values.setEnabled(capability, enabled);
+
+    add(values);
+}
+
 void State::addCapability(Capability * capability)
 {
     if (m_capabilities.find(capability->capability()) != m_capabilities.end())
@@ -317,7 +576,20 @@ void State::add(StateSetting * setting)
     m_settings[type] = setting;
 
     if (m_mode == ImmediateMode)
-        setting->apply();
+        applyChanged(*setting, StateRegistry::current());
+}
+
+void State::add(const StateBlock & values)
+{
+    m_block.merge(values);
+
+    if (m_mode == ImmediateMode)
+        applyChanged(values, StateRegistry::current());
+}
+
+const StateBlock & State::block() const
+{
+    return m_block;
 }
 
 } // namespace globjects
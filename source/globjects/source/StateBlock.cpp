@@ -0,0 +1,848 @@
+#include <globjects/StateBlock.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/StateSetting.h>
+
+using namespace gl;
+
+namespace
+{
+
+using globjects::StateBlock;
+
+struct FieldLayout
+{
+    unsigned int offset;
+    unsigned int size;
+};
+
+// offset and number of words of each field, in order of StateBlock::Field
+const FieldLayout s_layout[StateBlock::FieldCount] = {
+    {  0, 4 }, // BlendColor
+    {  4, 4 }, // BlendFunc
+    {  8, 4 }, // ClearColor
+    { 12, 1 }, // ClearDepth
+    { 13, 1 }, // ClearStencil
+    { 14, 4 }, // ColorMask
+    { 18, 1 }, // CullFace
+    { 19, 1 }, // DepthFunc
+    { 20, 1 }, // DepthMask
+    { 21, 2 }, // DepthRange
+    { 23, 1 }, // FrontFace
+    { 24, 1 }, // LogicOp
+    { 25, 1 }, // PointSize
+    { 26, 1 }, // PolygonModeFront
+    { 27, 1 }, // PolygonModeBack
+    { 28, 2 }, // PolygonOffset
+    { 30, 1 }, // PrimitiveRestartIndex
+    { 31, 1 }, // ProvokingVertex
+    { 32, 2 }, // SampleCoverage
+    { 34, 4 }, // Scissor
+    { 38, 3 }, // StencilFuncFront
+    { 41, 3 }, // StencilFuncBack
+    { 44, 3 }, // StencilOpFront
+    { 47, 3 }, // StencilOpBack
+    { 50, 1 }, // StencilMaskFront
+    { 51, 1 }  // StencilMaskBack
+};
+
+const GLenum s_capabilities[] = {
+    GL_BLEND,
+    GL_COLOR_LOGIC_OP,
+    GL_CULL_FACE,
+    GL_DEPTH_CLAMP,
+    GL_DEPTH_TEST,
+    GL_DITHER,
+    GL_FRAMEBUFFER_SRGB,
+    GL_LINE_SMOOTH,
+    GL_MULTISAMPLE,
+    GL_POLYGON_OFFSET_FILL,
+    GL_POLYGON_OFFSET_LINE,
+    GL_POLYGON_OFFSET_POINT,
+    GL_POLYGON_SMOOTH,
+    GL_PROGRAM_POINT_SIZE,
+    GL_RASTERIZER_DISCARD,
+    GL_SAMPLE_ALPHA_TO_COVERAGE,
+    GL_SAMPLE_ALPHA_TO_ONE,
+    GL_SAMPLE_COVERAGE,
+    GL_SAMPLE_MASK,
+    GL_SCISSOR_TEST,
+    GL_STENCIL_TEST,
+    GL_PRIMITIVE_RESTART,
+    GL_PRIMITIVE_RESTART_FIXED_INDEX,
+    GL_SAMPLE_SHADING,
+    GL_TEXTURE_CUBE_MAP_SEAMLESS,
+    GL_DEBUG_OUTPUT,
+    GL_DEBUG_OUTPUT_SYNCHRONOUS
+};
+
+const unsigned int s_capabilityCount = sizeof(s_capabilities) / sizeof(GLenum);
+
+static_assert(s_capabilityCount <= 32, "Standard capabilities exceed the capability masks");
+static_assert(std::is_standard_layout<StateBlock>::value, "StateBlock has to be a flat type");
+
+int capabilityIndex(const GLenum capability)
+{
+    const GLenum * it = std::find(s_capabilities, s_capabilities + s_capabilityCount, capability);
+
+    return it == s_capabilities + s_capabilityCount ? -1 : static_cast<int>(it - s_capabilities);
+}
+
+std::uint32_t bit(const unsigned int index)
+{
+    return std::uint32_t(1) << index;
+}
+
+unsigned int bitCount(std::uint32_t bits)
+{
+    unsigned int count = 0;
+
+    for (; bits; bits &= bits - 1)
+        ++count;
+
+    return count;
+}
+
+std::uint32_t word(const GLfloat value)
+{
+    std::uint32_t result;
+    std::memcpy(&result, &value, sizeof(result));
+
+    return result;
+}
+
+std::uint32_t word(const GLint value)
+{
+    return static_cast<std::uint32_t>(value);
+}
+
+std::uint32_t word(const GLuint value)
+{
+    return value;
+}
+
+std::uint32_t word(const GLenum value)
+{
+    return static_cast<std::uint32_t>(value);
+}
+
+std::uint32_t word(const GLboolean value)
+{
+    return static_cast<std::uint32_t>(value);
+}
+
+GLfloat toFloat(const std::uint32_t value)
+{
+    GLfloat result;
+    std::memcpy(&result, &value, sizeof(result));
+
+    return result;
+}
+
+GLenum toEnum(const std::uint32_t value)
+{
+    return static_cast<GLenum>(value);
+}
+
+GLboolean toBoolean(const std::uint32_t value)
+{
+    return static_cast<GLboolean>(value);
+}
+
+GLint toInt(const std::uint32_t value)
+{
+    return static_cast<GLint>(value);
+}
+
+void applyField(const StateBlock::Field field, const std::uint32_t * v)
+{
+    switch (field)
+    {
+    case StateBlock::BlendColor:
+        glBlendColor(toFloat(v[0]), toFloat(v[1]), toFloat(v[2]), toFloat(v[3]));
+        break;
+    case StateBlock::BlendFunc:
+        glBlendFuncSeparate(toEnum(v[0]), toEnum(v[1]), toEnum(v[2]), toEnum(v[3]));
+        break;
+    case StateBlock::ClearColor:
+        glClearColor(toFloat(v[0]), toFloat(v[1]), toFloat(v[2]), toFloat(v[3]));
+        break;
+    case StateBlock::ClearDepth:
+        glClearDepth(toFloat(v[0]));
+        break;
+    case StateBlock::ClearStencil:
+        glClearStencil(toInt(v[0]));
+        break;
+    case StateBlock::ColorMask:
+        glColorMask(toBoolean(v[0]), toBoolean(v[1]), toBoolean(v[2]), toBoolean(v[3]));
+        break;
+    case StateBlock::CullFace:
+        glCullFace(toEnum(v[0]));
+        break;
+    case StateBlock::DepthFunc:
+        glDepthFunc(toEnum(v[0]));
+        break;
+    case StateBlock::DepthMask:
+        glDepthMask(toBoolean(v[0]));
+        break;
+    case StateBlock::DepthRange:
+        glDepthRange(toFloat(v[0]), toFloat(v[1]));
+        break;
+    case StateBlock::FrontFace:
+        glFrontFace(toEnum(v[0]));
+        break;
+    case StateBlock::LogicOp:
+        glLogicOp(toEnum(v[0]));
+        break;
+    case StateBlock::PointSize:
+        glPointSize(toFloat(v[0]));
+        break;
+    case StateBlock::PolygonModeFront:
+        glPolygonMode(GL_FRONT, toEnum(v[0]));
+        break;
+    case StateBlock::PolygonModeBack:
+        glPolygonMode(GL_BACK, toEnum(v[0]));
+        break;
+    case StateBlock::PolygonOffset:
+        glPolygonOffset(toFloat(v[0]), toFloat(v[1]));
+        break;
+    case StateBlock::PrimitiveRestartIndex:
+        glPrimitiveRestartIndex(v[0]);
+        break;
+    case StateBlock::ProvokingVertex:
+        glProvokingVertex(toEnum(v[0]));
+        break;
+    case StateBlock::SampleCoverage:
+        glSampleCoverage(toFloat(v[0]), toBoolean(v[1]));
+        break;
+    case StateBlock::Scissor:
+        glScissor(toInt(v[0]), toInt(v[1]), toInt(v[2]), toInt(v[3]));
+        break;
+    case StateBlock::StencilFuncFront:
+        glStencilFuncSeparate(GL_FRONT, toEnum(v[0]), toInt(v[1]), v[2]);
+        break;
+    case StateBlock::StencilFuncBack:
+        glStencilFuncSeparate(GL_BACK, toEnum(v[0]), toInt(v[1]), v[2]);
+        break;
+    case StateBlock::StencilOpFront:
+        glStencilOpSeparate(GL_FRONT, toEnum(v[0]), toEnum(v[1]), toEnum(v[2]));
+        break;
+    case StateBlock::StencilOpBack:
+        glStencilOpSeparate(GL_BACK, toEnum(v[0]), toEnum(v[1]), toEnum(v[2]));
+        break;
+    case StateBlock::StencilMaskFront:
+        glStencilMaskSeparate(GL_FRONT, v[0]);
+        break;
+    case StateBlock::StencilMaskBack:
+        glStencilMaskSeparate(GL_BACK, v[0]);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
+
+globjects::StateSetting * faceSetting(globjects::StateSetting * setting, const GLenum face)
+{
+    setting->type().specializeType(face);
+
+    return setting;
+}
+
+globjects::StateSetting * createSetting(const StateBlock::Field field, const std::uint32_t * v)
+{
+    using globjects::StateSetting;
+
+    switch (field)
+    {
+    case StateBlock::BlendColor:
+        return new StateSetting(glBlendColor, toFloat(v[0]), toFloat(v[1]), toFloat(v[2]), toFloat(v[3]));
+    case StateBlock::BlendFunc:
+        return new StateSetting(glBlendFuncSeparate, toEnum(v[0]), toEnum(v[1]), toEnum(v[2]), toEnum(v[3]));
+    case StateBlock::ClearColor:
+        return new StateSetting(glClearColor, toFloat(v[0]), toFloat(v[1]), toFloat(v[2]), toFloat(v[3]));
+    case StateBlock::ClearDepth:
+        return new StateSetting(glClearDepth, static_cast<GLdouble>(toFloat(v[0])));
+    case StateBlock::ClearStencil:
+        return new StateSetting(glClearStencil, toInt(v[0]));
+    case StateBlock::ColorMask:
+        return new StateSetting(glColorMask, toBoolean(v[0]), toBoolean(v[1]), toBoolean(v[2]), toBoolean(v[3]));
+    case StateBlock::CullFace:
+        return new StateSetting(glCullFace, toEnum(v[0]));
+    case StateBlock::DepthFunc:
+        return new StateSetting(glDepthFunc, toEnum(v[0]));
+    case StateBlock::DepthMask:
+        return new StateSetting(glDepthMask, toBoolean(v[0]));
+    case StateBlock::DepthRange:
+        return new StateSetting(glDepthRange, static_cast<GLdouble>(toFloat(v[0])), static_cast<GLdouble>(toFloat(v[1])));
+    case StateBlock::FrontFace:
+        return new StateSetting(glFrontFace, toEnum(v[0]));
+    case StateBlock::LogicOp:
+        return new StateSetting(glLogicOp, toEnum(v[0]));
+    case StateBlock::PointSize:
+        return new StateSetting(glPointSize, toFloat(v[0]));
+    case StateBlock::PolygonModeFront:
+        return faceSetting(new StateSetting(glPolygonMode, GLenum(GL_FRONT), toEnum(v[0])), GL_FRONT);
+    case StateBlock::PolygonModeBack:
+        return faceSetting(new StateSetting(glPolygonMode, GLenum(GL_BACK), toEnum(v[0])), GL_BACK);
+    case StateBlock::PolygonOffset:
+        return new StateSetting(glPolygonOffset, toFloat(v[0]), toFloat(v[1]));
+    case StateBlock::PrimitiveRestartIndex:
+        return new StateSetting(glPrimitiveRestartIndex, GLuint(v[0]));
+    case StateBlock::ProvokingVertex:
+        return new StateSetting(glProvokingVertex, toEnum(v[0]));
+    case StateBlock::SampleCoverage:
+        return new StateSetting(glSampleCoverage, toFloat(v[0]), toBoolean(v[1]));
+    case StateBlock::Scissor:
+        return new StateSetting(glScissor, toInt(v[0]), toInt(v[1]), GLsizei(toInt(v[2])), GLsizei(toInt(v[3])));
+    case StateBlock::StencilFuncFront:
+        return faceSetting(new StateSetting(glStencilFuncSeparate, GLenum(GL_FRONT), toEnum(v[0]), toInt(v[1]), GLuint(v[2])), GL_FRONT);
+    case StateBlock::StencilFuncBack:
+        return faceSetting(new StateSetting(glStencilFuncSeparate, GLenum(GL_BACK), toEnum(v[0]), toInt(v[1]), GLuint(v[2])), GL_BACK);
+    case StateBlock::StencilOpFront:
+        return faceSetting(new StateSetting(glStencilOpSeparate, GLenum(GL_FRONT), toEnum(v[0]), toEnum(v[1]), toEnum(v[2])), GL_FRONT);
+    case StateBlock::StencilOpBack:
+        return faceSetting(new StateSetting(glStencilOpSeparate, GLenum(GL_BACK), toEnum(v[0]), toEnum(v[1]), toEnum(v[2])), GL_BACK);
+    case StateBlock::StencilMaskFront:
+        return faceSetting(new StateSetting(glStencilMaskSeparate, GLenum(GL_FRONT), GLuint(v[0])), GL_FRONT);
+    case StateBlock::StencilMaskBack:
+        return faceSetting(new StateSetting(glStencilMaskSeparate, GLenum(GL_BACK), GLuint(v[0])), GL_BACK);
+    default:
+        assert(false);
+        return nullptr;
+    }
+}
+
+StateBlock createDefaults()
+{
+    StateBlock block;
+
+    for (const GLenum capability : s_capabilities)
+    {
+        if (capability == GL_DEBUG_OUTPUT || capability == GL_DEBUG_OUTPUT_SYNCHRONOUS)
+            continue;
+
+        block.setEnabled(capability, capability == GL_DITHER || capability == GL_MULTISAMPLE);
+    }
+
+    block.blendColor(0.f, 0.f, 0.f, 0.f);
+    block.blendFunc(GL_ONE, GL_ZERO);
+    block.colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    block.cullFace(GL_BACK);
+    block.depthFunc(GL_LESS);
+    block.depthMask(GL_TRUE);
+    block.depthRange(0.f, 1.f);
+    block.frontFace(GL_CCW);
+    block.logicOp(GL_COPY);
+    block.pointSize(1.f);
+    block.polygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    block.polygonOffset(0.f, 0.f);
+    block.primitiveRestartIndex(0);
+    block.provokingVertex(GL_LAST_VERTEX_CONVENTION);
+    block.sampleCoverage(1.f, GL_FALSE);
+    block.stencilFuncSeparate(GL_FRONT_AND_BACK, GL_ALWAYS, 0, ~0u);
+    block.stencilMaskSeparate(GL_FRONT_AND_BACK, ~0u);
+    block.stencilOpSeparate(GL_FRONT_AND_BACK, GL_KEEP, GL_KEEP, GL_KEEP);
+
+    return block;
+}
+
+}
+
+namespace globjects
+{
+
+bool StateBlock::isStandardCapability(const GLenum capability)
+{
+    return capabilityIndex(capability) >= 0;
+}
+
+const StateBlock & StateBlock::defaults()
+{
+    static const StateBlock block = createDefaults();
+
+    return block;
+}
+
+StateBlock::StateBlock()
+: m_fields(0)
+, m_capabilities(0)
+, m_enabled(0)
+{
+    m_values.fill(0);
+}
+
+bool StateBlock::isEmpty() const
+{
+    return m_fields == 0 && m_capabilities == 0;
+}
+
+unsigned int StateBlock::count() const
+{
+    return bitCount(m_fields) + bitCount(m_capabilities);
+}
+
+bool StateBlock::isSet(const Field field) const
+{
+    return (m_fields & bit(field)) != 0;
+}
+
+std::uint32_t StateBlock::fields() const
+{
+    return m_fields;
+}
+
+void StateBlock::unset(const std::uint32_t fields)
+{
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (!(fields & m_fields & bit(field)))
+            continue;
+
+        std::fill_n(m_values.begin() + s_layout[field].offset, s_layout[field].size, 0u);
+    }
+
+    m_fields &= ~fields;
+}
+
+bool StateBlock::isSet(const GLenum capability) const
+{
+    const int index = capabilityIndex(capability);
+
+    return index >= 0 && (m_capabilities & bit(index)) != 0;
+}
+
+bool StateBlock::isEnabled(const GLenum capability) const
+{
+    const int index = capabilityIndex(capability);
+
+    return index >= 0 && (m_enabled & bit(index)) != 0;
+}
+
+void StateBlock::setEnabled(const GLenum capability, const bool enabled)
+{
+    const int index = capabilityIndex(capability);
+    assert(index >= 0);
+
+    if (index < 0)
+        return;
+
+    m_capabilities |= bit(index);
+
+    if (enabled)
+        m_enabled |= bit(index);
+    else
+        m_enabled &= ~bit(index);
+}
+
+void StateBlock::unsetCapability(const GLenum capability)
+{
+    const int index = capabilityIndex(capability);
+    if (index < 0)
+        return;
+
+    m_capabilities &= ~bit(index);
+    m_enabled &= ~bit(index);
+}
+
+void StateBlock::unsetCapabilities()
+{
+    m_capabilities = 0;
+    m_enabled = 0;
+}
+
+void StateBlock::blendColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha)
+{
+    const std::uint32_t values[] = { word(red), word(green), word(blue), word(alpha) };
+    set(BlendColor, values);
+}
+
+void StateBlock::blendFunc(const GLenum sFactor, const GLenum dFactor)
+{
+    blendFuncSeparate(sFactor, dFactor, sFactor, dFactor);
+}
+
+void StateBlock::blendFuncSeparate(const GLenum srcRGB, const GLenum dstRGB, const GLenum srcAlpha, const GLenum dstAlpha)
+{
+    const std::uint32_t values[] = { word(srcRGB), word(dstRGB), word(srcAlpha), word(dstAlpha) };
+    set(BlendFunc, values);
+}
+
+void StateBlock::clearColor(const GLfloat red, const GLfloat green, const GLfloat blue, const GLfloat alpha)
+{
+    const std::uint32_t values[] = { word(red), word(green), word(blue), word(alpha) };
+    set(ClearColor, values);
+}
+
+void StateBlock::clearDepth(const GLfloat depth)
+{
+    const std::uint32_t values[] = { word(depth) };
+    set(ClearDepth, values);
+}
+
+void StateBlock::clearStencil(const GLint s)
+{
+    const std::uint32_t values[] = { word(s) };
+    set(ClearStencil, values);
+}
+
+void StateBlock::colorMask(const GLboolean red, const GLboolean green, const GLboolean blue, const GLboolean alpha)
+{
+    const std::uint32_t values[] = { word(red), word(green), word(blue), word(alpha) };
+    set(ColorMask, values);
+}
+
+void StateBlock::cullFace(const GLenum mode)
+{
+    const std::uint32_t values[] = { word(mode) };
+    set(CullFace, values);
+}
+
+void StateBlock::depthFunc(const GLenum func)
+{
+    const std::uint32_t values[] = { word(func) };
+    set(DepthFunc, values);
+}
+
+void StateBlock::depthMask(const GLboolean flag)
+{
+    const std::uint32_t values[] = { word(flag) };
+    set(DepthMask, values);
+}
+
+void StateBlock::depthRange(const GLfloat nearVal, const GLfloat farVal)
+{
+    const std::uint32_t values[] = { word(nearVal), word(farVal) };
+    set(DepthRange, values);
+}
+
+void StateBlock::frontFace(const GLenum winding)
+{
+    const std::uint32_t values[] = { word(winding) };
+    set(FrontFace, values);
+}
+
+void StateBlock::logicOp(const GLenum opcode)
+{
+    const std::uint32_t values[] = { word(opcode) };
+    set(LogicOp, values);
+}
+
+void StateBlock::pointSize(const GLfloat size)
+{
+    const std::uint32_t values[] = { word(size) };
+    set(PointSize, values);
+}
+
+void StateBlock::polygonMode(const GLenum face, const GLenum mode)
+{
+    const std::uint32_t values[] = { word(mode) };
+    setFace(PolygonModeFront, PolygonModeBack, face, values);
+}
+
+void StateBlock::polygonOffset(const GLfloat factor, const GLfloat units)
+{
+    const std::uint32_t values[] = { word(factor), word(units) };
+    set(PolygonOffset, values);
+}
+
+void StateBlock::primitiveRestartIndex(const GLuint index)
+{
+    const std::uint32_t values[] = { word(index) };
+    set(PrimitiveRestartIndex, values);
+}
+
+void StateBlock::provokingVertex(const GLenum provokeMode)
+{
+    const std::uint32_t values[] = { word(provokeMode) };
+    set(ProvokingVertex, values);
+}
+
+void StateBlock::sampleCoverage(const GLfloat value, const GLboolean invert)
+{
+    const std::uint32_t values[] = { word(value), word(invert) };
+    set(SampleCoverage, values);
+}
+
+void StateBlock::scissor(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+{
+    const std::uint32_t values[] = { word(x), word(y), word(width), word(height) };
+    set(Scissor, values);
+}
+
+void StateBlock::stencilFuncSeparate(const GLenum face, const GLenum func, const GLint ref, const GLuint mask)
+{
+    const std::uint32_t values[] = { word(func), word(ref), word(mask) };
+    setFace(StencilFuncFront, StencilFuncBack, face, values);
+}
+
+void StateBlock::stencilMaskSeparate(const GLenum face, const GLuint mask)
+{
+    const std::uint32_t values[] = { word(mask) };
+    setFace(StencilMaskFront, StencilMaskBack, face, values);
+}
+
+void StateBlock::stencilOpSeparate(const GLenum face, const GLenum stencilFail, const GLenum depthFail, const GLenum depthPass)
+{
+    const std::uint32_t values[] = { word(stencilFail), word(depthFail), word(depthPass) };
+    setFace(StencilOpFront, StencilOpBack, face, values);
+}
+
+void StateBlock::set(const Field field, const std::uint32_t * values)
+{
+    std::copy(values, values + s_layout[field].size, m_values.begin() + s_layout[field].offset);
+
+    m_fields |= bit(field);
+}
+
+void StateBlock::setFace(const Field front, const Field back, const GLenum face, const std::uint32_t * values)
+{
+    if (face == GL_FRONT || face == GL_FRONT_AND_BACK)
+        set(front, values);
+
+    if (face == GL_BACK || face == GL_FRONT_AND_BACK)
+        set(back, values);
+}
+
+bool StateBlock::equals(const StateBlock & other, const Field field) const
+{
+    const auto begin = m_values.begin() + s_layout[field].offset;
+
+    return std::equal(begin, begin + s_layout[field].size, other.m_values.begin() + s_layout[field].offset);
+}
+
+std::vector<GLenum> StateBlock::capabilities() const
+{
+    std::vector<GLenum> capabilities;
+
+    for (unsigned int index = 0; index < s_capabilityCount; ++index)
+    {
+        if (m_capabilities & bit(index))
+            capabilities.push_back(s_capabilities[index]);
+    }
+
+    return capabilities;
+}
+
+std::vector<StateSetting *> StateBlock::settings() const
+{
+    std::vector<StateSetting *> settings;
+
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (m_fields & bit(field))
+            settings.push_back(createSetting(static_cast<Field>(field), m_values.data() + s_layout[field].offset));
+    }
+
+    return settings;
+}
+
+void StateBlock::merge(const StateBlock & other)
+{
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (other.m_fields & bit(field))
+            set(static_cast<Field>(field), other.m_values.data() + s_layout[field].offset);
+    }
+
+    m_capabilities |= other.m_capabilities;
+    m_enabled = (m_enabled & ~other.m_capabilities) | other.m_enabled;
+}
+
+StateBlock StateBlock::completed(const StateBlock & previous) const
+{
+    const StateBlock & initial = defaults();
+
+    const std::uint32_t capabilities = previous.m_capabilities & ~m_capabilities & initial.m_capabilities;
+    const std::uint32_t fields = previous.m_fields & ~m_fields & initial.m_fields;
+
+    StateBlock result = *this;
+    result.m_capabilities |= capabilities;
+    result.m_enabled |= initial.m_enabled & capabilities;
+
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (fields & bit(field))
+            result.set(static_cast<Field>(field), initial.m_values.data() + s_layout[field].offset);
+    }
+
+    return result;
+}
+
+void StateBlock::apply() const
+{
+    applyCapabilities(m_capabilities);
+    applyFields(m_fields);
+}
+
+unsigned int StateBlock::applyDiff(const StateBlock & from) const
+{
+    const std::uint32_t capabilities = changedCapabilities(from);
+    const std::uint32_t fields = changedFields(from);
+
+    applyCapabilities(capabilities);
+    applyFields(fields);
+
+    return bitCount(capabilities) + bitCount(fields);
+}
+
+StateBlock StateBlock::difference(const StateBlock & from) const
+{
+    const std::uint32_t capabilities = changedCapabilities(from);
+    const std::uint32_t fields = changedFields(from);
+
+    StateBlock result;
+    result.m_capabilities = capabilities;
+    result.m_enabled = m_enabled & capabilities;
+
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (fields & bit(field))
+            result.set(static_cast<Field>(field), m_values.data() + s_layout[field].offset);
+    }
+
+    return result;
+}
+
+std::uint32_t StateBlock::changedCapabilities(const StateBlock & from) const
+{
+    const std::uint32_t unchanged = m_capabilities & from.m_capabilities & ~(m_enabled ^ from.m_enabled);
+
+    return m_capabilities & ~unchanged;
+}
+
+std::uint32_t StateBlock::changedFields(const StateBlock & from) const
+{
+    std::uint32_t fields = m_fields;
+
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if ((fields & from.m_fields & bit(field)) && equals(from, static_cast<Field>(field)))
+            fields &= ~bit(field);
+    }
+
+    return fields;
+}
+
+void StateBlock::applyCapabilities(const std::uint32_t capabilities) const
+{
+    for (unsigned int index = 0; index < s_capabilityCount; ++index)
+    {
+        if (!(capabilities & bit(index)))
+            continue;
+
+        if (m_enabled & bit(index))
+            glEnable(s_capabilities[index]);
+        else
+            glDisable(s_capabilities[index]);
+    }
+}
+
+void StateBlock::applyFields(std::uint32_t fields) const
+{
+    // faces set to the same values are applied with a single call
+    const auto bothFaces = [this, &fields](const Field front, const Field back)
+    {
+        const std::uint32_t mask = bit(front) | bit(back);
+        if ((fields & mask) != mask)
+            return false;
+
+        const auto begin = m_values.begin() + s_layout[front].offset;
+        if (!std::equal(begin, begin + s_layout[front].size, m_values.begin() + s_layout[back].offset))
+            return false;
+
+        fields &= ~mask;
+
+        return true;
+    };
+
+    const std::uint32_t * values = m_values.data();
+
+    if (bothFaces(PolygonModeFront, PolygonModeBack))
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, toEnum(values[s_layout[PolygonModeFront].offset]));
+    }
+
+    if (bothFaces(StencilFuncFront, StencilFuncBack))
+    {
+        const std::uint32_t * v = values + s_layout[StencilFuncFront].offset;
+        glStencilFunc(toEnum(v[0]), toInt(v[1]), v[2]);
+    }
+
+    if (bothFaces(StencilOpFront, StencilOpBack))
+    {
+        const std::uint32_t * v = values + s_layout[StencilOpFront].offset;
+        glStencilOp(toEnum(v[0]), toEnum(v[1]), toEnum(v[2]));
+    }
+
+    if (bothFaces(StencilMaskFront, StencilMaskBack))
+    {
+        glStencilMask(values[s_layout[StencilMaskFront].offset]);
+    }
+
+    for (unsigned int field = 0; field < FieldCount; ++field)
+    {
+        if (fields & bit(field))
+            applyField(static_cast<Field>(field), values + s_layout[field].offset);
+    }
+}
+
+bool StateBlock::operator==(const StateBlock & other) const
+{
+    return m_fields == other.m_fields
+        && m_capabilities == other.m_capabilities
+        && m_enabled == other.m_enabled
+        && m_values == other.m_values;
+}
+
+bool StateBlock::operator!=(const StateBlock & other) const
+{
+    return !(*this == other);
+}
+
+bool StateBlock::operator<(const StateBlock & other) const
+{
+    return std::tie(m_fields, m_capabilities, m_enabled, m_values)
+        < std::tie(other.m_fields, other.m_capabilities, other.m_enabled, other.m_values);
+}
+
+std::size_t StateBlock::hash() const
+{
+    // FNV-1a over all words; unset fields are zero
+    std::size_t hash = 2166136261u;
+
+    const auto combine = [&hash](const std::uint32_t value)
+    {
+        hash = (hash ^ value) * 16777619u;
+    };
+
+    combine(m_fields);
+    combine(m_capabilities);
+    combine(m_enabled);
+
+    for (const std::uint32_t value : m_values)
+        combine(value);
+
+    return hash;
+}
+
+} // namespace globjects
+
+namespace std
+{
+
+size_t hash<globjects::StateBlock>::operator()(const globjects::StateBlock & block) const
+{
+    return block.hash();
+}
+
+} // namespace std
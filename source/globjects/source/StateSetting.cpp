@@ -3,6 +3,8 @@
 
 #include <glbinding/gl/enum.h>
 
+#include <globjects/base/AbstractFunctionCall.h>
+
 using namespace gl;
 
 namespace globjects
@@ -28,6 +30,11 @@ std::size_t StateSettingType::hash() const
     return std::hash<void*>()(m_functionIdentifier);
 }
 
+void * StateSettingType::functionIdentifier() const
+{
+    return m_functionIdentifier;
+}
+
 void StateSettingType::specializeType(const GLenum subtype)
 {
     m_subtypes.insert(subtype);
@@ -41,6 +48,7 @@ StateSetting::StateSetting(AbstractFunctionCall * functionCall)
 
 StateSetting::~StateSetting()
 {
+    delete m_functionCall;
 }
 
 void StateSetting::apply()
@@ -49,6 +57,23 @@ void StateSetting::apply()
 
 }
 
+StateSetting * StateSetting::clone() const
+{
+    AbstractFunctionCall * functionCall = m_functionCall->clone();
+    if (!functionCall)
+        return nullptr;
+
+    StateSetting * setting = new StateSetting(functionCall);
+    setting->m_type = m_type;
+
+    return setting;
+}
+
+bool StateSetting::equals(const StateSetting & other) const
+{
+    return m_type == other.m_type && m_functionCall->equals(*other.m_functionCall);
+}
+
 const StateSettingType & StateSetting::type() const
 {
     return m_type;
@@ -0,0 +1,99 @@
+#include <globjects/StateStack.h>
+
+#include <globjects/StateBlock.h>
+#include <globjects/logging.h>
+
+#include "registry/StateRegistry.h"
+
+
+namespace
+{
+
+using globjects::StateBlock;
+using globjects::StateStack;
+
+std::uint32_t field(const StateBlock::Field field)
+{
+    return std::uint32_t(1) << field;
+}
+
+std::uint32_t fields(const unsigned int mask)
+{
+    std::uint32_t result = 0;
+
+    if (mask & StateStack::Blend)
+        result |= field(StateBlock::BlendColor) | field(StateBlock::BlendFunc);
+
+    if (mask & StateStack::Depth)
+        result |= field(StateBlock::DepthFunc) | field(StateBlock::DepthMask) | field(StateBlock::DepthRange);
+
+    if (mask & StateStack::Stencil)
+        result |= field(StateBlock::StencilFuncFront) | field(StateBlock::StencilFuncBack)
+            | field(StateBlock::StencilOpFront) | field(StateBlock::StencilOpBack)
+            | field(StateBlock::StencilMaskFront) | field(StateBlock::StencilMaskBack);
+
+    if (mask & StateStack::Rasterization)
+        result |= field(StateBlock::CullFace) | field(StateBlock::FrontFace)
+            | field(StateBlock::PolygonModeFront) | field(StateBlock::PolygonModeBack)
+            | field(StateBlock::PolygonOffset) | field(StateBlock::PointSize)
+            | field(StateBlock::LogicOp) | field(StateBlock::SampleCoverage)
+            | field(StateBlock::PrimitiveRestartIndex) | field(StateBlock::ProvokingVertex);
+
+    if (mask & StateStack::Scissor)
+        result |= field(StateBlock::Scissor);
+
+    if (mask & StateStack::Clear)
+        result |= field(StateBlock::ClearColor) | field(StateBlock::ClearDepth) | field(StateBlock::ClearStencil);
+
+    if (mask & StateStack::ColorMask)
+        result |= field(StateBlock::ColorMask);
+
+    return result;
+}
+
+}
+
+namespace globjects
+{
+
+void StateStack::push(const unsigned int mask)
+{
+    StateRegistry & shadow = StateRegistry::current();
+
+    StateBlock saved = shadow.block();
+    saved.unset(~fields(mask));
+
+    if (!(mask & Capabilities))
+        saved.unsetCapabilities();
+
+    shadow.stack().push_back(saved);
+}
+
+unsigned int StateStack::pop()
+{
+    StateRegistry & shadow = StateRegistry::current();
+
+    if (shadow.stack().empty())
+    {
+        warning() << "StateStack::pop() without matching push()";
+        return 0;
+    }
+
+    const StateBlock saved = shadow.stack().back();
+    shadow.stack().pop_back();
+
+    const unsigned int issued = saved.applyDiff(shadow.block());
+
+    shadow.block().merge(saved);
+    shadow.countIssued(issued);
+    shadow.countElided(saved.count() - issued);
+
+    return issued;
+}
+
+unsigned int StateStack::depth()
+{
+    return static_cast<unsigned int>(StateRegistry::current().stack().size());
+}
+
+} // namespace globjects
@@ -1,5 +1,7 @@
 #include <globjects/Texture.h>
 
+#include <cassert>
+
 #include <glbinding/gl/enum.h>
 #include <glbinding/gl/functions.h>
 #include <glbinding/gl/boolean.h>
@@ -11,6 +13,8 @@
 
 #include "pixelformat.h"
 #include "Resource.h"
+#include "registry/BindingRegistry.h"
+#include "registry/DeletionRegistry.h"
 
 
 using namespace gl;
@@ -43,6 +47,8 @@ Texture * Texture::fromId(const GLuint id, const GLenum target)
 
 Texture::~Texture()
 {
+    if (isContextCurrent())
+        DeletionRegistry::current().forget(DeletionRegistry::Textures, id());
 }
 
 Texture * Texture::createDefault()
@@ -65,7 +71,8 @@ Texture * Texture::createDefault(const GLenum target)
 
 void Texture::bind() const
 {
-    glBindTexture(m_target, id());
+    if (BindingRegistry::current().bindTexture(m_target, id()))
+        glBindTexture(m_target, id());
 }
 
 void Texture::unbind() const
@@ -75,19 +82,30 @@ void Texture::unbind() const
 
 void Texture::unbind(const GLenum target)
 {
-    glBindTexture(target, 0);
+    if (BindingRegistry::current().bindTexture(target, 0))
+        glBindTexture(target, 0);
 }
 
 void Texture::bindActive(const GLenum texture) const
 {
-    glActiveTexture(texture);
-    glBindTexture(m_target, id());
+    BindingRegistry & bindings = BindingRegistry::current();
+
+    if (bindings.activeTexture(texture))
+        glActiveTexture(texture);
+
+    if (bindings.bindTexture(m_target, id()))
+        glBindTexture(m_target, id());
 }
 
 void Texture::unbindActive(const GLenum texture) const
 {
-    glActiveTexture(texture);
-    glBindTexture(m_target, 0);
+    BindingRegistry & bindings = BindingRegistry::current();
+
+    if (bindings.activeTexture(texture))
+        glActiveTexture(texture);
+
+    if (bindings.bindTexture(m_target, 0))
+        glBindTexture(m_target, 0);
 }
 
 GLenum Texture::target() const
@@ -242,6 +260,13 @@ void Texture::subImage2D(const GLint level, const glm::ivec2& offset, const glm:
     subImage2D(level, offset.x, offset.y, size.x, size.y, format, type, data);
 }
 
+TextureUploader::Token Texture::subImage2DAsync(const GLint level, const glm::ivec2& offset, const glm::ivec2& size, const GLenum format, const GLenum type, const GLvoid * data, TextureUploader * uploader)
+{
+    assert(uploader != nullptr);
+
+    return uploader->subImage2D(this, level, offset, size, format, type, data);
+}
+
 void Texture::image3D(const GLint level, const GLenum internalFormat, const GLsizei width, const GLsizei height, const GLsizei depth, const GLint border, const GLenum format, const GLenum type, const GLvoid* data)
 {
     bind();
@@ -278,6 +303,13 @@ void Texture::subImage3D(const GLint level, const glm::ivec3& offset, const glm:
     subImage3D(level, offset.x, offset.y, offset.z, size.x, size.y, size.z, format, type, data);
 }
 
+TextureUploader::Token Texture::subImage3DAsync(const GLint level, const glm::ivec3& offset, const glm::ivec3& size, const GLenum format, const GLenum type, const GLvoid * data, TextureUploader * uploader)
+{
+    assert(uploader != nullptr);
+
+    return uploader->subImage3D(this, level, offset, size, format, type, data);
+}
+
 void Texture::image2DMultisample(const GLsizei samples, const GLenum internalFormat, const GLsizei width, const GLsizei height, const GLboolean fixedSamplesLocations)
 {
     bind();
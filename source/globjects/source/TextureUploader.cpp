@@ -0,0 +1,358 @@
+#include <globjects/TextureUploader.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <globjects/globjects.h>
+#include <globjects/Buffer.h>
+#include <globjects/Sync.h>
+#include <globjects/Texture.h>
+
+#include "pixelformat.h"
+
+
+using namespace gl;
+
+namespace
+{
+
+// offsets into the pixel unpack buffer have to be aligned to the pixel type's size
+const GLsizeiptr s_stagingAlignment = 16;
+
+GLsizeiptr nextMultiple(const GLsizeiptr n, const GLsizeiptr k)
+{
+    return (n + k - 1) / k * k;
+}
+
+bool isSignaled(globjects::Sync * sync)
+{
+    return static_cast<GLenum>(sync->get(GL_SYNC_STATUS)) == GL_SIGNALED;
+}
+
+}
+
+namespace globjects
+{
+
+TextureUploader::TextureUploader(const GLsizeiptr stagingBufferSize, const unsigned int stagingBufferCount)
+: m_stagingBufferSize(stagingBufferSize)
+, m_persistent(hasExtension(GLextension::GL_ARB_buffer_storage))
+, m_stagingBuffers(stagingBufferCount)
+, m_budget(2000)
+, m_nextToken(1)
+, m_issued(0)
+, m_fenced(0)
+, m_completed(0)
+{
+    assert(stagingBufferSize > 0);
+    assert(stagingBufferCount > 0);
+
+    for (StagingBuffer & staging : m_stagingBuffers)
+    {
+        staging.buffer = new Buffer();
+        staging.mapping = nullptr;
+        staging.used = 0;
+
+        if (m_persistent)
+        {
+            staging.buffer->setStorage(m_stagingBufferSize, nullptr, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            staging.mapping = static_cast<char *>(staging.buffer->mapRange(0, m_stagingBufferSize, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+        }
+        else
+        {
+            staging.buffer->setData(m_stagingBufferSize, nullptr, GL_STREAM_DRAW);
+        }
+    }
+}
+
+TextureUploader::~TextureUploader()
+{
+    // queued uploads still reference client memory
+    finish();
+
+    if (!m_persistent)
+        return;
+
+    for (StagingBuffer & staging : m_stagingBuffers)
+        staging.buffer->unmap();
+}
+
+const std::chrono::microseconds & TextureUploader::budget() const
+{
+    return m_budget;
+}
+
+void TextureUploader::setBudget(const std::chrono::microseconds & budget)
+{
+    m_budget = budget;
+}
+
+TextureUploader::Token TextureUploader::subImage2D(Texture * texture, const GLint level, const glm::ivec2 & offset, const glm::ivec2 & size, const GLenum format, const GLenum type, const GLvoid * data)
+{
+    Upload upload;
+    upload.texture = texture;
+    upload.is3D = false;
+    upload.level = level;
+    upload.offset = glm::ivec3(offset.x, offset.y, 0);
+    upload.size = glm::ivec3(size.x, size.y, 1);
+    upload.format = format;
+    upload.type = type;
+
+    return enqueue(upload, data);
+}
+
+TextureUploader::Token TextureUploader::subImage3D(Texture * texture, const GLint level, const glm::ivec3 & offset, const glm::ivec3 & size, const GLenum format, const GLenum type, const GLvoid * data)
+{
+    Upload upload;
+    upload.texture = texture;
+    upload.is3D = true;
+    upload.level = level;
+    upload.offset = offset;
+    upload.size = size;
+    upload.format = format;
+    upload.type = type;
+
+    return enqueue(upload, data);
+}
+
+void TextureUploader::process()
+{
+    process(m_budget);
+}
+
+void TextureUploader::process(const std::chrono::microseconds & budget)
+{
+    issueChunks(budget);
+}
+
+bool TextureUploader::isComplete(const Token token)
+{
+    if (token > m_completed)
+        reclaim();
+
+    return token <= m_completed;
+}
+
+void TextureUploader::finish(const Token token)
+{
+    assert(token < m_nextToken);
+
+    while (m_issued < token)
+    {
+        if (!issueChunks(std::chrono::microseconds::max()))
+            waitForOldest();
+    }
+
+    while (m_completed < token)
+        waitForOldest();
+}
+
+void TextureUploader::finish()
+{
+    finish(m_nextToken - 1);
+}
+
+std::size_t TextureUploader::pendingCount() const
+{
+    return m_pending.size();
+}
+
+TextureUploader::Token TextureUploader::enqueue(Upload & upload, const GLvoid * data)
+{
+    assert(upload.texture != nullptr);
+
+    upload.token = m_nextToken++;
+    upload.data = static_cast<const char *>(data);
+    upload.alignment = getInteger(GL_UNPACK_ALIGNMENT);
+    upload.packedRowSize = static_cast<GLsizeiptr>(bytesPerPixel(upload.format, upload.type)) * upload.size.x;
+    upload.rowSize = nextMultiple(upload.packedRowSize, upload.alignment);
+    upload.nextRow = 0;
+
+    m_pending.push_back(upload);
+
+    return upload.token;
+}
+
+bool TextureUploader::issueChunks(const std::chrono::microseconds & budget)
+{
+    reclaim();
+
+    if (m_pending.empty())
+        return true;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    const GLint previousAlignment = getInteger(GL_UNPACK_ALIGNMENT);
+    GLint alignment = previousAlignment;
+
+    std::vector<StagingBuffer *> used;
+    StagingBuffer * staging = nullptr;
+
+    bool progress = false;
+
+    while (!m_pending.empty())
+    {
+        Upload & upload = m_pending.front();
+
+        if (upload.rowSize == 0 || upload.nextRow >= upload.size.y * upload.size.z)
+        {
+            m_issued = upload.token;
+            m_pending.pop_front();
+            continue;
+        }
+
+        if (progress && std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start) >= budget)
+            break;
+
+        if (staging == nullptr)
+        {
+            staging = acquireStagingBuffer();
+
+            if (staging == nullptr)
+                break;
+        }
+
+        if (alignment != upload.alignment)
+        {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, upload.alignment);
+            alignment = upload.alignment;
+        }
+
+        // chunks never span multiple slices
+        const GLint rowsLeftInSlice = upload.size.y - upload.nextRow % upload.size.y;
+
+        // n rows require (n - 1) * rowSize + packedRowSize bytes, the last row is not padded
+        const GLsizeiptr stagingOffset = nextMultiple(staging->used, s_stagingAlignment);
+        const GLsizeiptr available = std::max(m_stagingBufferSize - stagingOffset, static_cast<GLsizeiptr>(0));
+        const GLsizeiptr fittingRows = available < upload.packedRowSize ? 0 : (available - upload.packedRowSize) / upload.rowSize + 1;
+
+        if (fittingRows > 0)
+        {
+            issueChunk(upload, *staging, stagingOffset, static_cast<GLint>(std::min(fittingRows, static_cast<GLsizeiptr>(rowsLeftInSlice))));
+
+            if (std::find(used.begin(), used.end(), staging) == used.end())
+                used.push_back(staging);
+        }
+        else if (staging->used == 0)
+        {
+            // a single row exceeds the staging buffer, thus it is uploaded from client memory
+            Buffer::unbind(GL_PIXEL_UNPACK_BUFFER);
+
+            update(upload, rowsLeftInSlice, upload.data + upload.nextRow * upload.rowSize);
+        }
+        else
+        {
+            staging = nullptr;
+            continue;
+        }
+
+        progress = true;
+    }
+
+    Buffer::unbind(GL_PIXEL_UNPACK_BUFFER);
+
+    if (alignment != previousAlignment)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
+
+    fence(used);
+
+    return progress;
+}
+
+void TextureUploader::issueChunk(Upload & upload, StagingBuffer & staging, const GLsizeiptr stagingOffset, const GLint rows)
+{
+    const GLsizeiptr size = (rows - 1) * upload.rowSize + upload.packedRowSize;
+    const char * source = upload.data + upload.nextRow * upload.rowSize;
+
+    if (m_persistent)
+    {
+        std::memcpy(staging.mapping + stagingOffset, source, static_cast<std::size_t>(size));
+    }
+    else
+    {
+        // the range is known to be unused by the GPU, as the buffer's fence was signaled
+        void * mapping = staging.buffer->mapRange(stagingOffset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        std::memcpy(mapping, source, static_cast<std::size_t>(size));
+        staging.buffer->unmap();
+    }
+
+    staging.used = stagingOffset + size;
+
+    staging.buffer->bind(GL_PIXEL_UNPACK_BUFFER);
+
+    update(upload, rows, reinterpret_cast<const GLvoid *>(stagingOffset));
+}
+
+void TextureUploader::update(Upload & upload, const GLint rows, const GLvoid * pixels)
+{
+    const GLint slice = upload.nextRow / upload.size.y;
+    const GLint row = upload.nextRow % upload.size.y;
+
+    if (upload.is3D)
+        upload.texture->subImage3D(upload.level, upload.offset.x, upload.offset.y + row, upload.offset.z + slice, upload.size.x, rows, 1, upload.format, upload.type, pixels);
+    else
+        upload.texture->subImage2D(upload.level, upload.offset.x, upload.offset.y + row, upload.size.x, rows, upload.format, upload.type, pixels);
+
+    upload.nextRow += rows;
+}
+
+TextureUploader::StagingBuffer * TextureUploader::acquireStagingBuffer()
+{
+    for (StagingBuffer & staging : m_stagingBuffers)
+    {
+        if (staging.fence == nullptr && staging.used == 0)
+            return &staging;
+    }
+
+    return nullptr;
+}
+
+void TextureUploader::fence(const std::vector<StagingBuffer *> & stagingBuffers)
+{
+    if (stagingBuffers.empty() && m_issued == m_fenced)
+        return;
+
+    ref_ptr<Sync> sync = Sync::fence(GL_SYNC_GPU_COMMANDS_COMPLETE);
+
+    for (StagingBuffer * staging : stagingBuffers)
+        staging->fence = sync;
+
+    m_fences.push_back(std::make_pair(m_issued, sync));
+    m_fenced = m_issued;
+}
+
+void TextureUploader::reclaim()
+{
+    while (!m_fences.empty() && isSignaled(m_fences.front().second))
+    {
+        m_completed = std::max(m_completed, m_fences.front().first);
+        m_fences.pop_front();
+    }
+
+    for (StagingBuffer & staging : m_stagingBuffers)
+    {
+        if (staging.fence == nullptr || !isSignaled(staging.fence))
+            continue;
+
+        staging.fence = nullptr;
+        staging.used = 0;
+    }
+}
+
+void TextureUploader::waitForOldest()
+{
+    if (m_fences.empty())
+        return;
+
+    m_fences.front().second->clientWait(GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+
+    reclaim();
+}
+
+} // namespace globjects
@@ -0,0 +1,206 @@
+#include <globjects/TiledRenderer.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <fstream>
+#include <memory>
+
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/enum.h>
+
+#include <globjects/globjects.h>
+#include <globjects/logging.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/FramebufferAttachment.h>
+#include <globjects/FramebufferCapture.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/RenderTargetPool.h>
+
+#include "registry/BindingRegistry.h"
+
+
+using namespace gl;
+
+namespace
+{
+
+GLenum depthAttachment(const GLenum internalFormat)
+{
+    return internalFormat == GL_DEPTH24_STENCIL8 || internalFormat == GL_DEPTH32F_STENCIL8
+        ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+}
+
+}
+
+namespace globjects
+{
+
+TiledRenderer::TiledRenderer(const glm::ivec2 & imageSize, const glm::ivec2 & tileSize)
+: m_imageSize(imageSize)
+, m_tileSize(tileSize)
+, m_colorInternalFormat(GL_RGBA8)
+, m_colorFormat(GL_RGBA)
+, m_colorType(GL_UNSIGNED_BYTE)
+, m_depthInternalFormat(GL_DEPTH_COMPONENT24)
+, m_fbo(new Framebuffer())
+, m_pool(new RenderTargetPool())
+, m_capture(new FramebufferCapture(2))
+{
+    assert(imageSize.x > 0 && imageSize.y > 0);
+
+    const std::array<GLint, 2> maxViewport = getIntegers<2>(GL_MAX_VIEWPORT_DIMS);
+    const GLint maxRenderbuffer = getInteger(GL_MAX_RENDERBUFFER_SIZE);
+
+    m_tileSize.x = std::min(std::min(m_tileSize.x, m_imageSize.x), std::min(maxViewport[0], maxRenderbuffer));
+    m_tileSize.y = std::min(std::min(m_tileSize.y, m_imageSize.y), std::min(maxViewport[1], maxRenderbuffer));
+}
+
+TiledRenderer::~TiledRenderer()
+{
+}
+
+const glm::ivec2 & TiledRenderer::imageSize() const
+{
+    return m_imageSize;
+}
+
+const glm::ivec2 & TiledRenderer::tileSize() const
+{
+    return m_tileSize;
+}
+
+void TiledRenderer::setColorFormat(const GLenum internalFormat, const GLenum format, const GLenum type)
+{
+    m_colorInternalFormat = internalFormat;
+    m_colorFormat = format;
+    m_colorType = type;
+}
+
+void TiledRenderer::setDepthFormat(const GLenum internalFormat)
+{
+    m_depthInternalFormat = internalFormat;
+}
+
+const std::vector<TiledRenderer::Tile> & TiledRenderer::tiles(const glm::mat4 & projection)
+{
+    m_tiles.clear();
+
+    for (int y = 0; y < m_imageSize.y; y += m_tileSize.y)
+    {
+        for (int x = 0; x < m_imageSize.x; x += m_tileSize.x)
+        {
+            Tile tile;
+            tile.index = static_cast<unsigned int>(m_tiles.size());
+            tile.offset = glm::ivec2(x, y);
+            tile.size = glm::ivec2(std::min(m_tileSize.x, m_imageSize.x - x), std::min(m_tileSize.y, m_imageSize.y - y));
+            tile.projection = tileProjection(m_imageSize, tile.offset, tile.size) * projection;
+
+            m_tiles.push_back(tile);
+        }
+    }
+
+    return m_tiles;
+}
+
+void TiledRenderer::render(const glm::mat4 & projection, const DrawCallback & draw, const TileCallback & receive)
+{
+    tiles(projection);
+
+    const std::array<GLint, 4> viewport = getIntegers<4>(GL_VIEWPORT);
+    const GLint packAlignment = getInteger(GL_PACK_ALIGNMENT);
+    const GLint drawFramebuffer = getInteger(GL_DRAW_FRAMEBUFFER_BINDING);
+    const GLint readFramebuffer = getInteger(GL_READ_FRAMEBUFFER_BINDING);
+
+    Renderbuffer * color = m_pool->renderbuffer(m_colorInternalFormat, m_tileSize);
+    m_fbo->attachRenderBuffer(GL_COLOR_ATTACHMENT0, color);
+
+    if (m_depthInternalFormat != GL_NONE)
+    {
+        m_fbo->attachRenderBuffer(depthAttachment(m_depthInternalFormat), m_pool->renderbuffer(m_depthInternalFormat, m_tileSize));
+
+        // depth is not needed once a tile was read back
+        m_fbo->getAttachment(depthAttachment(m_depthInternalFormat))->setTransient(true);
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    // tile i is delivered while tile i + 1 is rendered
+    const unsigned long long firstFrame = m_capture->capturedFrames();
+    m_capture->setCallback([this, firstFrame, &receive](const FramebufferCapture::Frame & frame)
+    {
+        receive(m_tiles[static_cast<std::size_t>(frame.index - firstFrame)], frame.data);
+    });
+
+    for (const Tile & tile : m_tiles)
+    {
+        m_fbo->bind(GL_FRAMEBUFFER);
+        glViewport(0, 0, tile.size.x, tile.size.y);
+
+        draw(tile);
+
+        m_capture->capture(m_fbo, GL_COLOR_ATTACHMENT0, {{ 0, 0, tile.size.x, tile.size.y }}, m_colorFormat, m_colorType);
+
+        // the tile's pass ends with its read back
+        m_fbo->invalidateTransientAttachments();
+    }
+
+    m_capture->flush();
+    m_capture->setCallback(nullptr);
+
+    m_fbo->detach(GL_COLOR_ATTACHMENT0);
+
+    if (m_depthInternalFormat != GL_NONE)
+        m_fbo->detach(depthAttachment(m_depthInternalFormat));
+
+    // keeps the attachments for subsequent renders, unless the formats change
+    m_pool->nextFrame();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+
+    BindingRegistry::current().bindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer));
+    BindingRegistry::current().bindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+}
+
+TiledRenderer::TileCallback TiledRenderer::rawFileWriter(const std::string & fileName, const glm::ivec2 & imageSize, const int bytesPerPixel)
+{
+    std::shared_ptr<std::ofstream> file = std::make_shared<std::ofstream>(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file->good())
+        critical() << "Could not open " << fileName << " for writing";
+
+    const std::streamoff imageRowSize = static_cast<std::streamoff>(imageSize.x) * bytesPerPixel;
+
+    return [file, imageRowSize, bytesPerPixel](const Tile & tile, const void * pixels)
+    {
+        if (!file->good())
+            return;
+
+        const char * data = static_cast<const char *>(pixels);
+        const std::streamoff tileRowSize = static_cast<std::streamoff>(tile.size.x) * bytesPerPixel;
+
+        for (int y = 0; y < tile.size.y; ++y)
+        {
+            file->seekp((tile.offset.y + y) * imageRowSize + static_cast<std::streamoff>(tile.offset.x) * bytesPerPixel);
+            file->write(data + y * tileRowSize, tileRowSize);
+        }
+    };
+}
+
+glm::mat4 TiledRenderer::tileProjection(const glm::ivec2 & imageSize, const glm::ivec2 & tileOffset, const glm::ivec2 & tileSize)
+{
+    // maps the tile's range in normalized device coordinates to [-1, 1]
+    glm::mat4 tile(1.0f);
+
+    tile[0][0] = static_cast<float>(imageSize.x) / tileSize.x;
+    tile[1][1] = static_cast<float>(imageSize.y) / tileSize.y;
+    tile[3][0] = static_cast<float>(imageSize.x - 2 * tileOffset.x - tileSize.x) / tileSize.x;
+    tile[3][1] = static_cast<float>(imageSize.y - 2 * tileOffset.y - tileSize.y) / tileSize.y;
+
+    return tile;
+}
+
+} // namespace globjects
@@ -12,6 +12,7 @@
 #include "implementations/AbstractVertexAttributeBindingImplementation.h"
 
 #include "container_helpers.hpp"
+#include "registry/BindingRegistry.h"
 #include "registry/ObjectRegistry.h"
 
 #include "Resource.h"
@@ -57,6 +58,8 @@ VertexArray * VertexArray::defaultVAO()
 
 VertexArray::~VertexArray()
 {
+    if (isContextCurrent())
+        BindingRegistry::current().forgetVertexArray(id());
 }
 
 void VertexArray::accept(ObjectVisitor & visitor)
@@ -66,12 +69,14 @@ void VertexArray::accept(ObjectVisitor & visitor)
 
 void VertexArray::bind() const
 {
-	glBindVertexArray(id());
+    if (BindingRegistry::current().bindVertexArray(id()))
+        glBindVertexArray(id());
 }
 
 void VertexArray::unbind()
 {
-	glBindVertexArray(0);
+    if (BindingRegistry::current().bindVertexArray(0))
+        glBindVertexArray(0);
 }
 
 VertexAttributeBinding * VertexArray::binding(const GLuint bindingIndex)
@@ -160,6 +165,12 @@ void VertexArray::multiDrawArraysIndirect(const GLenum mode, const void* indirec
     glMultiDrawArraysIndirect(mode, indirect, drawCount, stride);
 }
 
+void VertexArray::multiDrawArraysIndirectCount(const GLenum mode, const void* indirect, const GLintptr drawCount, const GLsizei maxDrawCount, const GLsizei stride) const
+{
+    bind();
+    glMultiDrawArraysIndirectCountARB(mode, indirect, drawCount, maxDrawCount, stride);
+}
+
 void VertexArray::drawElements(const GLenum mode, const GLsizei count, const GLenum type, const void * indices) const
 {
     bind();
@@ -214,6 +225,12 @@ void VertexArray::multiDrawElementsIndirect(const GLenum mode, const GLenum type
     glMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
 }
 
+void VertexArray::multiDrawElementsIndirectCount(const GLenum mode, const GLenum type, const void* indirect, const GLintptr drawCount, const GLsizei maxDrawCount, const GLsizei stride) const
+{
+    bind();
+    glMultiDrawElementsIndirectCountARB(mode, type, indirect, drawCount, maxDrawCount, stride);
+}
+
 void VertexArray::drawRangeElements(const GLenum mode, const GLuint start, const GLuint end, const GLsizei count, const GLenum type, const void* indices) const
 {
     bind();
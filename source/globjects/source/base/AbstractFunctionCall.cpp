@@ -11,4 +11,14 @@ AbstractFunctionCall::~AbstractFunctionCall()
 {
 }
 
+AbstractFunctionCall * AbstractFunctionCall::clone() const
+{
+    return nullptr;
+}
+
+bool AbstractFunctionCall::equals(const AbstractFunctionCall & /*other*/) const
+{
+    return false;
+}
+
 } // namespace globjects
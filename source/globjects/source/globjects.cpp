@@ -17,6 +17,9 @@
 #include "registry/ObjectRegistry.h"
 #include "registry/ExtensionRegistry.h"
 #include "registry/ImplementationRegistry.h"
+#include "registry/StateRegistry.h"
+#include "registry/BindingRegistry.h"
+#include "registry/DeletionRegistry.h"
 
 #include <globjects/DebugMessage.h>
 #include <globjects/logging.h>
@@ -284,11 +287,15 @@ bool isInCoreProfile(const GLextension extension)
 void enable(const GLenum capability)
 {
     glEnable(capability);
+
+    StateRegistry::current().setCurrent(capability, true);
 }
 
 void disable(const GLenum capability)
 {
     glDisable(capability);
+
+    StateRegistry::current().setCurrent(capability, false);
 }
 
 bool isEnabled(const GLenum capability)
@@ -306,11 +313,15 @@ void setEnabled(const GLenum capability, const bool enabled)
 void enable(const GLenum capability, const int index)
 {
     glEnablei(capability, index);
+
+    StateRegistry::current().setCurrent(capability, index, true);
 }
 
 void disable(const GLenum capability, const int index)
 {
     glDisablei(capability, index);
+
+    StateRegistry::current().setCurrent(capability, index, false);
 }
 
 bool isEnabled(const GLenum capability, const int index)
@@ -325,6 +336,16 @@ void setEnabled(const GLenum capability, const int index, const bool enabled)
     enabled ? enable(capability, index) : disable(capability, index);
 }
 
+void invalidateBindings()
+{
+    BindingRegistry::current().invalidate();
+}
+
+unsigned int processDeletionQueue()
+{
+    return Registry::current().deletions().process() + Registry::current().containerDeletions().process();
+}
+
 void initializeStrategy(const AbstractUniform::BindlessImplementation impl)
 {
     Registry::current().implementations().initialize(impl);
@@ -19,6 +19,9 @@ public:
     static AbstractBufferImplementation * get(Buffer::BindlessImplementation impl = 
         Buffer::BindlessImplementation::DirectStateAccessARB);
 
+    /** \brief Generates n names for the name pool; create() completes the creation of a pooled name.
+    */
+    virtual void generate(gl::GLsizei n, gl::GLuint * ids) const = 0;
     virtual gl::GLuint create() const = 0;
     virtual void destroy(gl::GLuint id) const = 0;
 
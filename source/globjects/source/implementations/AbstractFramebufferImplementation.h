@@ -22,6 +22,9 @@ public:
         Framebuffer::BindlessImplementation::DirectStateAccessARB);
 
 
+    /** \brief Generates n names for the name pool; create() completes the creation of a pooled name.
+    */
+    virtual void generate(gl::GLsizei n, gl::GLuint * ids) const = 0;
     virtual gl::GLuint create() const = 0;
     virtual void destroy(gl::GLuint id) const = 0;
 
@@ -34,6 +37,8 @@ public:
     virtual void setReadBuffer(const Framebuffer * fbo, gl::GLenum mode) const = 0;
     virtual void setDrawBuffer(const Framebuffer * fbo, gl::GLenum mode) const = 0;
     virtual void setDrawBuffers(const Framebuffer * fbo, gl::GLsizei n, const gl::GLenum * modes) const = 0;
+    virtual void invalidate(const Framebuffer * fbo, gl::GLsizei numAttachments, const gl::GLenum * attachments) const = 0;
+    virtual void invalidateSub(const Framebuffer * fbo, gl::GLsizei numAttachments, const gl::GLenum * attachments, gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height) const = 0;
 
 public:
     static gl::GLenum s_workingTarget;
@@ -8,18 +8,22 @@
 
 #include "BufferImplementation_Legacy.h"
 
+#include "../registry/NameRegistry.h"
+
 
 using namespace gl;
 
 namespace globjects 
 {
 
-GLuint BufferImplementation_DirectStateAccessARB::create() const
+void BufferImplementation_DirectStateAccessARB::generate(const GLsizei n, GLuint * ids) const
 {
-    GLuint buffer;
-    glCreateBuffers(1, &buffer); // create a handle as well as the actual buffer
+    glCreateBuffers(n, ids); // create handles as well as the actual buffers
+}
 
-    return buffer;
+GLuint BufferImplementation_DirectStateAccessARB::create() const
+{
+    return NameRegistry::generate(NameRegistry::Buffers);
 }
 
 void BufferImplementation_DirectStateAccessARB::destroy(const GLuint id) const
@@ -14,6 +14,7 @@ class BufferImplementation_DirectStateAccessARB : public AbstractBufferImplement
     , public Singleton<BufferImplementation_DirectStateAccessARB>
 {
 public:
+    virtual void generate(gl::GLsizei n, gl::GLuint * ids) const override;
     virtual gl::GLuint create() const override;
     virtual void destroy(gl::GLuint id) const override;
 
@@ -14,6 +14,11 @@ using namespace gl;
 namespace globjects 
 {
 
+void BufferImplementation_DirectStateAccessEXT::generate(const GLsizei n, GLuint * ids) const
+{
+    BufferImplementation_Legacy::instance()->generate(n, ids);
+}
+
 GLuint BufferImplementation_DirectStateAccessEXT::create() const
 {
     return BufferImplementation_Legacy::instance()->create();
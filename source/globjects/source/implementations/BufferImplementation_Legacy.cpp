@@ -7,6 +7,9 @@
 
 #include <globjects/Buffer.h>
 
+#include "../registry/BindingRegistry.h"
+#include "../registry/NameRegistry.h"
+
 
 using namespace gl;
 
@@ -15,11 +18,16 @@ namespace globjects
 
 GLenum BufferImplementation_Legacy::s_workingTarget = GL_COPY_WRITE_BUFFER;
 
+void BufferImplementation_Legacy::generate(const GLsizei n, GLuint * ids) const
+{
+    glGenBuffers(n, ids); // create handles to potentially used buffers
+}
+
 GLuint BufferImplementation_Legacy::create() const
 {
-    GLuint buffer;
-    glGenBuffers(1, &buffer); // create a handle to a potentially used buffer
+    GLuint buffer = NameRegistry::generate(NameRegistry::Buffers);
     glBindBuffer(s_workingTarget, buffer); // trigger actual buffer creation
+    BindingRegistry::current().bindBuffer(s_workingTarget, buffer);
 
     return buffer;
 }
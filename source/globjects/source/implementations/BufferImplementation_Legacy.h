@@ -12,6 +12,7 @@ class BufferImplementation_Legacy : public AbstractBufferImplementation
     , public Singleton<BufferImplementation_Legacy>
 {
 public:
+    virtual void generate(gl::GLsizei n, gl::GLuint * ids) const override;
     virtual gl::GLuint create() const override;
     virtual void destroy(gl::GLuint id) const override;
 
@@ -10,18 +10,22 @@
 
 #include "FramebufferImplementation_Legacy.h"
 
+#include "../registry/NameRegistry.h"
+
 
 using namespace gl;
 
 namespace globjects 
 {
 
-GLuint FramebufferImplementation_DirectStateAccessARB::create() const
+void FramebufferImplementation_DirectStateAccessARB::generate(const GLsizei n, GLuint * ids) const
 {
-    GLuint frameBuffer;
-    glCreateFramebuffers(1, &frameBuffer); // create a handle as well as the actual buffer
+    glCreateFramebuffers(n, ids); // create handles as well as the actual framebuffers
+}
 
-    return frameBuffer;
+GLuint FramebufferImplementation_DirectStateAccessARB::create() const
+{
+    return NameRegistry::generate(NameRegistry::Framebuffers);
 }
 
 void FramebufferImplementation_DirectStateAccessARB::destroy(const GLuint id) const
@@ -80,4 +84,14 @@ void FramebufferImplementation_DirectStateAccessARB::setDrawBuffers(const Frameb
     glNamedFramebufferDrawBuffers(fbo->id(), n, modes);
 }
 
+void FramebufferImplementation_DirectStateAccessARB::invalidate(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments) const
+{
+    glInvalidateNamedFramebufferData(fbo->id(), numAttachments, attachments);
+}
+
+void FramebufferImplementation_DirectStateAccessARB::invalidateSub(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments, GLint x, GLint y, GLsizei width, GLsizei height) const
+{
+    glInvalidateNamedFramebufferSubData(fbo->id(), numAttachments, attachments, x, y, width, height);
+}
+
 } // namespace globjects
@@ -16,6 +16,11 @@ using namespace gl;
 namespace globjects 
 {
 
+void FramebufferImplementation_DirectStateAccessEXT::generate(const GLsizei n, GLuint * ids) const
+{
+    FramebufferImplementation_Legacy::instance()->generate(n, ids);
+}
+
 GLuint FramebufferImplementation_DirectStateAccessEXT::create() const
 {
     return FramebufferImplementation_Legacy::instance()->create();
@@ -77,4 +82,14 @@ void FramebufferImplementation_DirectStateAccessEXT::setDrawBuffers(const Frameb
     glFramebufferDrawBuffersEXT(fbo->id(), n, modes);
 }
 
+void FramebufferImplementation_DirectStateAccessEXT::invalidate(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments) const
+{
+    FramebufferImplementation_Legacy::instance()->invalidate(fbo, numAttachments, attachments);
+}
+
+void FramebufferImplementation_DirectStateAccessEXT::invalidateSub(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments, GLint x, GLint y, GLsizei width, GLsizei height) const
+{
+    FramebufferImplementation_Legacy::instance()->invalidateSub(fbo, numAttachments, attachments, x, y, width, height);
+}
+
 } // namespace globjects
@@ -8,17 +8,37 @@
 #include <globjects/Texture.h>
 #include <globjects/Renderbuffer.h>
 
+#include "../registry/BindingRegistry.h"
+#include "../registry/NameRegistry.h"
+
 
 using namespace gl;
 
+namespace
+{
+
+// binds to configure or query the framebuffer, unlike Framebuffer::bind() not counted as writes
+void bindWorking(const globjects::Framebuffer * fbo, const GLenum target)
+{
+    if (globjects::BindingRegistry::current().bindFramebuffer(target, fbo->id()))
+        glBindFramebuffer(target, fbo->id());
+}
+
+}
+
 namespace globjects 
 {
 
+void FramebufferImplementation_Legacy::generate(const GLsizei n, GLuint * ids) const
+{
+    glGenFramebuffers(n, ids); // create handles to potentially used framebuffers
+}
+
 GLuint FramebufferImplementation_Legacy::create() const
 {
-    GLuint framebuffer;
-    glGenFramebuffers(1, &framebuffer); // create a handle to a potentially used framebuffer
+    GLuint framebuffer = NameRegistry::generate(NameRegistry::Framebuffers);
     glBindFramebuffer(s_workingTarget, framebuffer); // trigger actual framebuffer creation
+    BindingRegistry::current().bindFramebuffer(s_workingTarget, framebuffer);
 
     return framebuffer;
 }
@@ -30,21 +50,21 @@ void FramebufferImplementation_Legacy::destroy(GLuint id) const
 
 GLenum FramebufferImplementation_Legacy::checkStatus(const Framebuffer * fbo) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
 
     return glCheckFramebufferStatus(s_workingTarget);
 }
 
 void FramebufferImplementation_Legacy::setParameter(const Framebuffer * fbo, GLenum pname, GLint param) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
 
     glFramebufferParameteri(s_workingTarget, pname, param);
 }
 
 GLint FramebufferImplementation_Legacy::getAttachmentParameter(const Framebuffer * fbo, GLenum attachment, GLenum pname) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
 
     GLint result = 0;
 
@@ -55,7 +75,7 @@ GLint FramebufferImplementation_Legacy::getAttachmentParameter(const Framebuffer
 
 void FramebufferImplementation_Legacy::attachTexture(const Framebuffer * fbo, GLenum attachment, Texture * texture, GLint level) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
 
     if (texture == nullptr)
     {
@@ -88,14 +108,14 @@ void FramebufferImplementation_Legacy::attachTexture(const Framebuffer * fbo, GL
 
 void FramebufferImplementation_Legacy::attachTextureLayer(const Framebuffer * fbo, GLenum attachment, Texture * texture, GLint level, GLint layer) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
 
     glFramebufferTextureLayer(s_workingTarget, attachment, texture ? texture->id() : 0, level, layer);
 }
 
 void FramebufferImplementation_Legacy::attachRenderBuffer(const Framebuffer * fbo, GLenum attachment, Renderbuffer * renderBuffer) const
 {
-    fbo->bind(s_workingTarget);
+    bindWorking(fbo, s_workingTarget);
     renderBuffer->bind();
 
     glFramebufferRenderbuffer(s_workingTarget, attachment, GL_RENDERBUFFER, renderBuffer->id());
@@ -103,23 +123,38 @@ void FramebufferImplementation_Legacy::attachRenderBuffer(const Framebuffer * fb
 
 void FramebufferImplementation_Legacy::setReadBuffer(const Framebuffer * fbo, GLenum mode) const
 {
-    fbo->bind(GL_READ_FRAMEBUFFER);
+    bindWorking(fbo, GL_READ_FRAMEBUFFER);
 
     glReadBuffer(mode);
 }
 
 void FramebufferImplementation_Legacy::setDrawBuffer(const Framebuffer * fbo, GLenum mode) const
 {
-    fbo->bind(GL_DRAW_FRAMEBUFFER);
+    bindWorking(fbo, GL_DRAW_FRAMEBUFFER);
 
     glDrawBuffer(mode);
 }
 
 void FramebufferImplementation_Legacy::setDrawBuffers(const Framebuffer * fbo, GLsizei n, const GLenum * modes) const
 {
-    fbo->bind(GL_DRAW_FRAMEBUFFER);
+    bindWorking(fbo, GL_DRAW_FRAMEBUFFER);
 
     glDrawBuffers(n, modes);
 }
 
+void FramebufferImplementation_Legacy::invalidate(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments) const
+{
+    // the read binding, as invalidation must not replace the current draw framebuffer
+    bindWorking(fbo, GL_READ_FRAMEBUFFER);
+
+    glInvalidateFramebuffer(GL_READ_FRAMEBUFFER, numAttachments, attachments);
+}
+
+void FramebufferImplementation_Legacy::invalidateSub(const Framebuffer * fbo, GLsizei numAttachments, const GLenum * attachments, GLint x, GLint y, GLsizei width, GLsizei height) const
+{
+    bindWorking(fbo, GL_READ_FRAMEBUFFER);
+
+    glInvalidateSubFramebuffer(GL_READ_FRAMEBUFFER, numAttachments, attachments, x, y, width, height);
+}
+
 } // namespace globjects
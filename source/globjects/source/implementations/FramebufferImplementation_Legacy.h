@@ -12,6 +12,7 @@ class FramebufferImplementation_Legacy : public AbstractFramebufferImplementatio
     , public Singleton<FramebufferImplementation_Legacy>
 {
 public:
+    virtual void generate(gl::GLsizei n, gl::GLuint * ids) const override;
     virtual gl::GLuint create() const override;
     virtual void destroy(gl::GLuint id) const override;
 
@@ -24,6 +25,8 @@ public:
     virtual void setReadBuffer(const Framebuffer * fbo, gl::GLenum mode) const override;
     virtual void setDrawBuffer(const Framebuffer * fbo, gl::GLenum mode) const override;
     virtual void setDrawBuffers(const Framebuffer * fbo, gl::GLsizei n, const gl::GLenum * modes) const override;
+    virtual void invalidate(const Framebuffer * fbo, gl::GLsizei numAttachments, const gl::GLenum * attachments) const override;
+    virtual void invalidateSub(const Framebuffer * fbo, gl::GLsizei numAttachments, const gl::GLenum * attachments, gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height) const override;
 };
 
 } // namespace globjects
@@ -34,12 +34,23 @@ VertexAttributeBindingImplementation_Legacy::Format::Format(
 {
 }
 
+bool VertexAttributeBindingImplementation_Legacy::Format::operator==(const Format & other) const
+{
+    return method == other.method && size == other.size && type == other.type
+        && normalized == other.normalized && relativeoffset == other.relativeoffset;
+}
+
 VertexAttributeBindingImplementation_Legacy::BindingData::BindingData()
 : baseoffset(0)
 , stride(0)
 , hasFormat(false)
 , hasBuffer(false)
 , hasAttribute(false)
+, applied(false)
+, appliedAttribute(-1)
+, appliedBufferSerial(0)
+, appliedBaseoffset(0)
+, appliedStride(0)
 {
 }
 
@@ -144,6 +155,24 @@ void VertexAttributeBindingImplementation_Legacy::finish(const VertexAttributeBi
 {
     assert(bindingData(binding) != nullptr);
 
+    BindingData & data = *bindingData(binding);
+
+    const GLint attribute = attributeIndex(binding);
+    // neither address nor id identify a buffer, both are reused after it was released
+    const unsigned int vboSerial = vbo(binding) ? vbo(binding)->serial() : 0;
+
+    // dynamic meshes often set identical layouts every frame
+    if (data.applied && data.appliedAttribute == attribute && data.appliedBufferSerial == vboSerial
+        && data.appliedFormat == data.format && data.appliedBaseoffset == data.baseoffset && data.appliedStride == data.stride)
+        return;
+
+    data.applied = true;
+    data.appliedAttribute = attribute;
+    data.appliedBufferSerial = vboSerial;
+    data.appliedFormat = data.format;
+    data.appliedBaseoffset = data.baseoffset;
+    data.appliedStride = data.stride;
+
     vao(binding)->bind();
 
     void * offset = nullptr;
@@ -159,8 +188,6 @@ void VertexAttributeBindingImplementation_Legacy::finish(const VertexAttributeBi
         Buffer::unbind(GL_ARRAY_BUFFER);
     }
 
-    const GLint attribute = attributeIndex(binding);
-
     switch (bindingData(binding)->format.method)
     {
     case Format::Method::I:
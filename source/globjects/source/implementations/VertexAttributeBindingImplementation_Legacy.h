@@ -45,6 +45,8 @@ protected:
         Format();
         Format(Method method, gl::GLint size, gl::GLenum type, gl::GLboolean normalized, gl::GLuint relativeoffset);
 
+        bool operator==(const Format & other) const;
+
         Method        method;
         gl::GLint     size;
         gl::GLenum    type;
@@ -62,6 +64,14 @@ protected:
         bool      hasFormat;
         bool      hasBuffer;
         bool      hasAttribute;
+
+        // last specification issued to OpenGL, to skip unchanged re-specifications
+        bool         applied;
+        gl::GLint    appliedAttribute;
+        unsigned int appliedBufferSerial;
+        Format       appliedFormat;
+        gl::GLint    appliedBaseoffset;
+        gl::GLint    appliedStride;
     };
 
     BindingData * & bindingData(const VertexAttributeBinding * binding) const;
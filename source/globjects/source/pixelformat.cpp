@@ -84,6 +84,10 @@ int numberOfComponents(const GLenum format)
     }
 }
 
+}
+
+namespace globjects {
+
 int bytesPerPixel(const GLenum format, const GLenum type)
 {
     switch (type) // several components encoded in type, disregard component count
@@ -117,10 +121,6 @@ int bytesPerPixel(const GLenum format, const GLenum type)
     return numberOfComponents(format) * byteSize(type);
 }
 
-}
-
-namespace globjects {
-
 int imageSizeInBytes(const int width, const int height, const GLenum format, const GLenum type)
 {
     if (type == GL_BITMAP)
@@ -4,6 +4,7 @@
 
 namespace globjects {
 
+int bytesPerPixel(gl::GLenum format, gl::GLenum type);
 int imageSizeInBytes(int width, int height, gl::GLenum format, gl::GLenum type);
 
 } // namespace globjects
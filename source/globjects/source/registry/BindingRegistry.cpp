@@ -0,0 +1,309 @@
+#include "BindingRegistry.h"
+#include "Registry.h"
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/logging.h>
+
+using namespace gl;
+
+namespace
+{
+
+bool update(bool & known, GLuint & current, const GLuint id)
+{
+    if (known && current == id)
+        return false;
+
+    known = true;
+    current = id;
+
+    return true;
+}
+
+template <typename Map>
+void eraseValue(Map & map, const GLuint id)
+{
+    for (auto it = map.begin(); it != map.end();)
+    {
+        if (it->second == id)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+}
+
+}
+
+namespace globjects
+{
+
+BindingRegistry::BindingRegistry()
+: m_activeTextureKnown(false)
+, m_activeTexture(GL_TEXTURE0)
+, m_vertexArrayKnown(false)
+, m_vertexArray(0)
+, m_readFramebufferKnown(false)
+, m_readFramebuffer(0)
+, m_drawFramebufferKnown(false)
+, m_drawFramebuffer(0)
+, m_programKnown(false)
+, m_program(0)
+, m_hasDeleted(false)
+{
+}
+
+BindingRegistry & BindingRegistry::current()
+{
+    return Registry::current().bindings();
+}
+
+bool BindingRegistry::bindBuffer(const GLenum target, const GLuint id)
+{
+    processDeleted();
+
+    auto it = m_buffers.find(target);
+    if (it != m_buffers.end() && it->second == id)
+        return false;
+
+    m_buffers[target] = id;
+
+    return true;
+}
+
+bool BindingRegistry::bindBufferBase(const GLenum target, const GLuint index, const GLuint id)
+{
+    IndexedBinding binding;
+    binding.id = id;
+    binding.offset = 0;
+    binding.size = -1;
+
+    return bindIndexed(target, index, binding);
+}
+
+bool BindingRegistry::bindBufferRange(const GLenum target, const GLuint index, const GLuint id, const GLintptr offset, const GLsizeiptr size)
+{
+    IndexedBinding binding;
+    binding.id = id;
+    binding.offset = offset;
+    binding.size = size;
+
+    return bindIndexed(target, index, binding);
+}
+
+bool BindingRegistry::bindIndexed(const GLenum target, const GLuint index, const IndexedBinding & binding)
+{
+    processDeleted();
+
+    auto it = m_indexedBuffers.find(IndexedTarget(target, index));
+    if (it != m_indexedBuffers.end() && it->second.id == binding.id && it->second.offset == binding.offset && it->second.size == binding.size)
+        return false;
+
+    m_indexedBuffers[IndexedTarget(target, index)] = binding;
+
+    // glBindBufferBase and glBindBufferRange bind the generic target as well
+    m_buffers[target] = binding.id;
+
+    return true;
+}
+
+bool BindingRegistry::activeTexture(const GLenum unit)
+{
+    if (m_activeTextureKnown && m_activeTexture == unit)
+        return false;
+
+    m_activeTextureKnown = true;
+    m_activeTexture = unit;
+
+    return true;
+}
+
+bool BindingRegistry::bindTexture(const GLenum target, const GLuint id)
+{
+    processDeleted();
+
+    // without a known unit the binding can not be attributed
+    if (!m_activeTextureKnown)
+        return true;
+
+#ifndef NDEBUG
+    checkActiveTexture();
+#endif
+
+    auto it = m_textures.find(TextureTarget(m_activeTexture, target));
+    if (it != m_textures.end() && it->second == id)
+        return false;
+
+    m_textures[TextureTarget(m_activeTexture, target)] = id;
+
+    return true;
+}
+
+void BindingRegistry::checkActiveTexture()
+{
+    GLint unit = 0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &unit);
+
+    if (static_cast<GLenum>(unit) == m_activeTexture)
+        return;
+
+    // reported only, as correcting the cache would make debug and release builds behave differently
+    warning() << "Active texture unit changed without globjects, call invalidateBindings() after glActiveTexture";
+}
+
+bool BindingRegistry::bindVertexArray(const GLuint id)
+{
+    if (!update(m_vertexArrayKnown, m_vertexArray, id))
+        return false;
+
+    // the element array buffer binding is part of the vertex array
+    m_buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+
+    return true;
+}
+
+bool BindingRegistry::bindFramebuffer(const GLenum target, const GLuint id)
+{
+    if (target == GL_READ_FRAMEBUFFER)
+        return update(m_readFramebufferKnown, m_readFramebuffer, id);
+
+    if (target == GL_DRAW_FRAMEBUFFER)
+        return update(m_drawFramebufferKnown, m_drawFramebuffer, id);
+
+    const bool readChanged = update(m_readFramebufferKnown, m_readFramebuffer, id);
+    const bool drawChanged = update(m_drawFramebufferKnown, m_drawFramebuffer, id);
+
+    return readChanged || drawChanged;
+}
+
+bool BindingRegistry::useProgram(const GLuint id)
+{
+    processDeleted();
+
+    return update(m_programKnown, m_program, id);
+}
+
+bool BindingRegistry::usedProgram(GLuint & id)
+{
+    processDeleted();
+
+    if (m_programKnown)
+        id = m_program;
+
+    return m_programKnown;
+}
+
+void BindingRegistry::forgetBuffer(const GLuint id)
+{
+    eraseValue(m_buffers, id);
+
+    for (auto it = m_indexedBuffers.begin(); it != m_indexedBuffers.end();)
+    {
+        if (it->second.id == id)
+            it = m_indexedBuffers.erase(it);
+        else
+            ++it;
+    }
+}
+
+void BindingRegistry::forgetTexture(const GLuint id)
+{
+    eraseValue(m_textures, id);
+}
+
+void BindingRegistry::forgetVertexArray(const GLuint id)
+{
+    if (m_vertexArray != id)
+        return;
+
+    m_vertexArrayKnown = false;
+    m_buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+}
+
+void BindingRegistry::forgetFramebuffer(const GLuint id)
+{
+    if (m_readFramebuffer == id)
+        m_readFramebufferKnown = false;
+
+    if (m_drawFramebuffer == id)
+        m_drawFramebufferKnown = false;
+}
+
+void BindingRegistry::forgetProgram(const GLuint id)
+{
+    if (m_program == id)
+        m_programKnown = false;
+}
+
+void BindingRegistry::forget(const DeletionRegistry::Type type, const GLuint id)
+{
+    switch (type)
+    {
+    case DeletionRegistry::Buffers:
+        forgetBuffer(id);
+        break;
+    case DeletionRegistry::Textures:
+        forgetTexture(id);
+        break;
+    case DeletionRegistry::Programs:
+        forgetProgram(id);
+        break;
+    case DeletionRegistry::Framebuffers:
+        forgetFramebuffer(id);
+        break;
+    case DeletionRegistry::VertexArrays:
+        forgetVertexArray(id);
+        break;
+    default:
+        // not cached
+        break;
+    }
+}
+
+void BindingRegistry::forgetDeleted(const DeletionRegistry::Names & names)
+{
+    std::lock_guard<std::mutex> lock(m_deletedMutex);
+
+    for (unsigned int type = 0; type < DeletionRegistry::TypeCount; ++type)
+        m_deleted[type].insert(m_deleted[type].end(), names[type].begin(), names[type].end());
+
+    m_hasDeleted.store(true, std::memory_order_release);
+}
+
+void BindingRegistry::processDeleted()
+{
+    if (!m_hasDeleted.load(std::memory_order_acquire))
+        return;
+
+    DeletionRegistry::Names names;
+
+    {
+        std::lock_guard<std::mutex> lock(m_deletedMutex);
+
+        names.swap(m_deleted);
+        m_hasDeleted.store(false, std::memory_order_relaxed);
+    }
+
+    for (unsigned int type = 0; type < DeletionRegistry::TypeCount; ++type)
+    {
+        for (const GLuint id : names[type])
+            forget(static_cast<DeletionRegistry::Type>(type), id);
+    }
+}
+
+void BindingRegistry::invalidate()
+{
+    m_buffers.clear();
+    m_indexedBuffers.clear();
+
+    m_activeTextureKnown = false;
+    m_textures.clear();
+
+    m_vertexArrayKnown = false;
+    m_readFramebufferKnown = false;
+    m_drawFramebufferKnown = false;
+    m_programKnown = false;
+}
+
+} // namespace globjects
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <glbinding/gl/types.h>
+
+#include "DeletionRegistry.h"
+
+namespace globjects
+{
+
+/** \brief Caches the objects bound in the current context through globjects, to skip redundant glBind* calls.
+
+    Like the state shadow, it is never shared between contexts. Each bind
+    function records the binding and returns whether it changed, i.e.,
+    whether the OpenGL call has to be issued. Bindings not made through
+    globjects are unknown and always considered to change. Deleting an
+    object forgets all its bindings; names of shared objects deleted by
+    another context of the share group are passed by forgetDeleted(), see
+    DeletionRegistry::forget(), and forgotten on the next bind.
+*/
+class BindingRegistry
+{
+public:
+    BindingRegistry();
+
+    static BindingRegistry & current();
+
+    bool bindBuffer(gl::GLenum target, gl::GLuint id);
+    bool bindBufferBase(gl::GLenum target, gl::GLuint index, gl::GLuint id);
+    bool bindBufferRange(gl::GLenum target, gl::GLuint index, gl::GLuint id, gl::GLintptr offset, gl::GLsizeiptr size);
+
+    bool activeTexture(gl::GLenum unit);
+    bool bindTexture(gl::GLenum target, gl::GLuint id);
+
+    bool bindVertexArray(gl::GLuint id);
+    bool bindFramebuffer(gl::GLenum target, gl::GLuint id);
+    bool useProgram(gl::GLuint id);
+
+    /** \brief Returns whether the used program is known, and if so, sets id.
+    */
+    bool usedProgram(gl::GLuint & id);
+
+    void forgetBuffer(gl::GLuint id);
+    void forgetTexture(gl::GLuint id);
+    void forgetVertexArray(gl::GLuint id);
+    void forgetFramebuffer(gl::GLuint id);
+    void forgetProgram(gl::GLuint id);
+    void forget(DeletionRegistry::Type type, gl::GLuint id);
+
+    /** \brief Queues names deleted by another context of the share group, forgotten on the next bind; thread-safe.
+    */
+    void forgetDeleted(const DeletionRegistry::Names & names);
+
+    /** \brief Forgets all bindings, e.g., after foreign code changed them.
+    */
+    void invalidate();
+
+protected:
+    struct IndexedBinding
+    {
+        gl::GLuint id;
+        gl::GLintptr offset;
+        gl::GLsizeiptr size;
+    };
+
+    using IndexedTarget = std::pair<gl::GLenum, gl::GLuint>;
+    using TextureTarget = std::pair<gl::GLenum, gl::GLenum>;
+
+    bool bindIndexed(gl::GLenum target, gl::GLuint index, const IndexedBinding & binding);
+
+    /** \brief Forgets the names queued by forgetDeleted(), if any.
+    */
+    void processDeleted();
+
+    /** \brief Warns if the cached active texture unit differs from the queried one, to detect foreign glActiveTexture calls (debug builds only).
+
+        The cache is left unchanged.
+    */
+    void checkActiveTexture();
+
+protected:
+    std::unordered_map<gl::GLenum, gl::GLuint> m_buffers;
+    std::map<IndexedTarget, IndexedBinding> m_indexedBuffers;
+
+    bool m_activeTextureKnown;
+    gl::GLenum m_activeTexture;
+    std::map<TextureTarget, gl::GLuint> m_textures;
+
+    bool m_vertexArrayKnown;
+    gl::GLuint m_vertexArray;
+
+    bool m_readFramebufferKnown;
+    gl::GLuint m_readFramebuffer;
+    bool m_drawFramebufferKnown;
+    gl::GLuint m_drawFramebuffer;
+
+    bool m_programKnown;
+    gl::GLuint m_program;
+
+    std::mutex m_deletedMutex;
+    std::atomic<bool> m_hasDeleted;
+    DeletionRegistry::Names m_deleted;
+};
+
+} // namespace globjects
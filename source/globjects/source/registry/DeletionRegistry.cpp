@@ -0,0 +1,149 @@
+#include "DeletionRegistry.h"
+#include "Registry.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <glbinding/gl/functions.h>
+
+#include "BindingRegistry.h"
+
+using namespace gl;
+
+namespace globjects
+{
+
+DeletionRegistry::DeletionRegistry()
+{
+}
+
+DeletionRegistry & DeletionRegistry::current()
+{
+    return Registry::current().deletions();
+}
+
+bool DeletionRegistry::isCurrent() const
+{
+    return Registry::hasCurrent() && (&current() == this || &Registry::current().containerDeletions() == this);
+}
+
+void DeletionRegistry::registerBindings(BindingRegistry * bindings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_bindings.push_back(bindings);
+}
+
+void DeletionRegistry::deregisterBindings(BindingRegistry * bindings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_bindings.erase(std::remove(m_bindings.begin(), m_bindings.end(), bindings), m_bindings.end());
+}
+
+void DeletionRegistry::forget(const Type type, const GLuint id)
+{
+    Names names;
+    names[type].push_back(id);
+
+    forget(names);
+}
+
+void DeletionRegistry::forget(const Names & names)
+{
+    BindingRegistry & current = BindingRegistry::current();
+
+    for (unsigned int type = 0; type < TypeCount; ++type)
+    {
+        for (const GLuint id : names[type])
+            current.forget(static_cast<Type>(type), id);
+    }
+
+    // the other contexts may be in use on other threads, their caches forget on the next bind
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (BindingRegistry * bindings : m_bindings)
+    {
+        if (bindings != &current)
+            bindings->forgetDeleted(names);
+    }
+}
+
+void DeletionRegistry::enqueue(const Type type, const GLuint id)
+{
+    assert(type < TypeCount);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_names[type].push_back(id);
+}
+
+unsigned int DeletionRegistry::process()
+{
+    assert(isCurrent());
+
+    Names names;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        names.swap(m_names);
+    }
+
+    // the names may be reused by subsequent glGen* calls and must not be considered bound any longer
+    forget(names);
+
+    // all buffer implementations delete buffers by glDeleteBuffers
+    if (!names[Buffers].empty())
+        glDeleteBuffers(static_cast<GLsizei>(names[Buffers].size()), names[Buffers].data());
+
+    if (!names[Textures].empty())
+        glDeleteTextures(static_cast<GLsizei>(names[Textures].size()), names[Textures].data());
+
+    if (!names[Samplers].empty())
+        glDeleteSamplers(static_cast<GLsizei>(names[Samplers].size()), names[Samplers].data());
+
+    if (!names[Renderbuffers].empty())
+        glDeleteRenderbuffers(static_cast<GLsizei>(names[Renderbuffers].size()), names[Renderbuffers].data());
+
+    // programs and shaders can only be deleted one at a time
+    for (const GLuint id : names[Programs])
+        glDeleteProgram(id);
+
+    for (const GLuint id : names[Shaders])
+        glDeleteShader(id);
+
+    // all framebuffer implementations delete framebuffers by glDeleteFramebuffers
+    if (!names[Framebuffers].empty())
+        glDeleteFramebuffers(static_cast<GLsizei>(names[Framebuffers].size()), names[Framebuffers].data());
+
+    if (!names[VertexArrays].empty())
+        glDeleteVertexArrays(static_cast<GLsizei>(names[VertexArrays].size()), names[VertexArrays].data());
+
+    if (!names[Queries].empty())
+        glDeleteQueries(static_cast<GLsizei>(names[Queries].size()), names[Queries].data());
+
+    if (!names[TransformFeedbacks].empty())
+        glDeleteTransformFeedbacks(static_cast<GLsizei>(names[TransformFeedbacks].size()), names[TransformFeedbacks].data());
+
+    unsigned int count = 0;
+
+    for (const std::vector<GLuint> & queue : names)
+        count += static_cast<unsigned int>(queue.size());
+
+    return count;
+}
+
+unsigned int DeletionRegistry::queued() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    unsigned int count = 0;
+
+    for (const std::vector<GLuint> & queue : m_names)
+        count += static_cast<unsigned int>(queue.size());
+
+    return count;
+}
+
+} // namespace globjects
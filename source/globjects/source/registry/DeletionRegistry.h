@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+namespace globjects
+{
+
+class BindingRegistry;
+
+
+/** \brief Queues the names of objects released while no context of their share group was current.
+
+    Like the object registry, it is shared between shared contexts. Names are
+    enqueued from any thread and deleted in bulk by process(), called with a
+    context of the share group current, e.g., once per frame.
+
+    Container objects, i.e., framebuffers, vertex arrays, queries and
+    transform feedbacks, are not shared between contexts. Their names are
+    queued in a registry of the creating context instead, which is processed
+    only with that context current.
+
+    Deleted names are forgotten by the binding caches of all contexts of the
+    share group, see forget().
+*/
+class DeletionRegistry
+{
+public:
+    enum Type
+    {
+        Buffers,
+        Textures,
+        Samplers,
+        Renderbuffers,
+        Programs,
+        Shaders,
+        Framebuffers,
+        VertexArrays,
+        Queries,
+        TransformFeedbacks,
+        TypeCount
+    };
+
+    using Names = std::array<std::vector<gl::GLuint>, TypeCount>;
+
+public:
+    DeletionRegistry();
+
+    static DeletionRegistry & current();
+
+    /** \brief Returns whether a context of this registry's share group, or its context for container objects, is current on the calling thread.
+    */
+    bool isCurrent() const;
+
+    void registerBindings(BindingRegistry * bindings);
+    void deregisterBindings(BindingRegistry * bindings);
+
+    /** \brief Forgets the bindings of a deleted name in the current context and, on their next bind, in all other contexts of the share group.
+    */
+    void forget(Type type, gl::GLuint id);
+
+    void enqueue(Type type, gl::GLuint id);
+
+    /** \brief Deletes all queued names; a context of the share group has to be current.
+        \return number of deleted names
+    */
+    unsigned int process();
+
+    unsigned int queued() const;
+
+protected:
+    void forget(const Names & names);
+
+protected:
+    mutable std::mutex m_mutex;
+    Names m_names;
+
+    /** Binding caches of the contexts of the share group, guarded by m_mutex */
+    std::vector<BindingRegistry *> m_bindings;
+};
+
+} // namespace globjects
@@ -0,0 +1,174 @@
+#include "NameRegistry.h"
+#include "Registry.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <glbinding/gl/functions.h>
+
+#include "ImplementationRegistry.h"
+
+#include "../implementations/AbstractBufferImplementation.h"
+#include "../implementations/AbstractFramebufferImplementation.h"
+
+using namespace gl;
+
+namespace globjects
+{
+
+const GLsizei NameRegistry::BatchSize;
+
+NameRegistry::NameRegistry()
+{
+    m_generators.fill(nullptr);
+}
+
+GLuint NameRegistry::generate(const Type type)
+{
+    Registry & registry = Registry::current();
+
+    return (isShared(type) ? registry.sharedNames() : registry.names()).acquire(type);
+}
+
+bool NameRegistry::isShared(const Type type)
+{
+    switch (type)
+    {
+    case Buffers:
+    case Textures:
+    case Samplers:
+    case Renderbuffers:
+        return true;
+    default:
+        return false;
+    }
+}
+
+GLuint NameRegistry::acquire(const Type type)
+{
+    assert(type < TypeCount);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<GLuint> & names = m_names[type];
+
+    // names generated by another implementation, e.g., glGen* names for direct state access, are unusable
+    if (!names.empty() && m_generators[type] != generator(type))
+        deleteNames(type);
+
+    if (names.empty())
+        prefetch(type);
+
+    // hand out in generation order
+    const GLuint name = names.back();
+    names.pop_back();
+
+    return name;
+}
+
+void NameRegistry::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (unsigned int type = 0; type < TypeCount; ++type)
+        deleteNames(static_cast<Type>(type));
+}
+
+const void * NameRegistry::generator(const Type type) const
+{
+    switch (type)
+    {
+    case Buffers:
+        return &ImplementationRegistry::current().bufferImplementation();
+    case Framebuffers:
+        return &ImplementationRegistry::current().framebufferImplementation();
+    default:
+        return nullptr;
+    }
+}
+
+void NameRegistry::prefetch(const Type type)
+{
+    std::vector<GLuint> & names = m_names[type];
+
+    names.resize(BatchSize);
+
+    switch (type)
+    {
+    case Buffers:
+        ImplementationRegistry::current().bufferImplementation().generate(BatchSize, names.data());
+        break;
+    case Textures:
+        glGenTextures(BatchSize, names.data());
+        break;
+    case Samplers:
+        glGenSamplers(BatchSize, names.data());
+        break;
+    case Renderbuffers:
+        glGenRenderbuffers(BatchSize, names.data());
+        break;
+    case Queries:
+        glGenQueries(BatchSize, names.data());
+        break;
+    case VertexArrays:
+        glGenVertexArrays(BatchSize, names.data());
+        break;
+    case Framebuffers:
+        ImplementationRegistry::current().framebufferImplementation().generate(BatchSize, names.data());
+        break;
+    case TransformFeedbacks:
+        glGenTransformFeedbacks(BatchSize, names.data());
+        break;
+    default:
+        break;
+    }
+
+    // acquire() takes names from the back
+    std::reverse(names.begin(), names.end());
+
+    m_generators[type] = generator(type);
+}
+
+void NameRegistry::deleteNames(const Type type)
+{
+    std::vector<GLuint> & names = m_names[type];
+
+    if (names.empty())
+        return;
+
+    const GLsizei count = static_cast<GLsizei>(names.size());
+
+    switch (type)
+    {
+    case Buffers:
+        glDeleteBuffers(count, names.data());
+        break;
+    case Textures:
+        glDeleteTextures(count, names.data());
+        break;
+    case Samplers:
+        glDeleteSamplers(count, names.data());
+        break;
+    case Renderbuffers:
+        glDeleteRenderbuffers(count, names.data());
+        break;
+    case Queries:
+        glDeleteQueries(count, names.data());
+        break;
+    case VertexArrays:
+        glDeleteVertexArrays(count, names.data());
+        break;
+    case Framebuffers:
+        glDeleteFramebuffers(count, names.data());
+        break;
+    case TransformFeedbacks:
+        glDeleteTransformFeedbacks(count, names.data());
+        break;
+    default:
+        break;
+    }
+
+    names.clear();
+}
+
+} // namespace globjects
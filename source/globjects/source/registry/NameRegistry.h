@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+namespace globjects
+{
+
+/** \brief Pools object names generated in batches, to avoid a glGen* call per object.
+
+    Names of objects shared between contexts are pooled per share group, names
+    of container objects (queries, vertex arrays, framebuffers, and transform
+    feedbacks) per context. Buffer and framebuffer names are generated by the
+    current implementation, i.e., by glCreate* for direct state access.
+    Pooled names are deleted by release() when their context is deregistered
+    while current; otherwise they are freed only with the context.
+*/
+class NameRegistry
+{
+public:
+    enum Type
+    {
+        Buffers,
+        Textures,
+        Samplers,
+        Renderbuffers,
+        Queries,
+        VertexArrays,
+        Framebuffers,
+        TransformFeedbacks,
+        TypeCount
+    };
+
+    static const gl::GLsizei BatchSize = 64;
+
+public:
+    NameRegistry();
+
+    /** \brief Returns an unused name from the pool of the current context or its share group.
+    */
+    static gl::GLuint generate(Type type);
+
+    static bool isShared(Type type);
+
+    gl::GLuint acquire(Type type);
+
+    /** \brief Deletes all pooled names. Requires a context of the pool to be current.
+    */
+    void release();
+
+protected:
+    const void * generator(Type type) const;
+    void prefetch(Type type);
+    void deleteNames(Type type);
+
+protected:
+    std::mutex m_mutex;
+    std::array<std::vector<gl::GLuint>, TypeCount> m_names;
+
+    // the implementation that generated the pooled buffer and framebuffer names
+    std::array<const void *, TypeCount> m_generators;
+};
+
+} // namespace globjects
@@ -23,6 +23,8 @@ ObjectRegistry & ObjectRegistry::current()
 
 std::set<Object*> ObjectRegistry::objects() const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     return m_objects;
 }
 
@@ -43,6 +45,8 @@ void ObjectRegistry::registerObject(Object * object)
 	if (object->id() == 0)
         return;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     m_objects.insert(object);
 }
 
@@ -53,6 +57,8 @@ void ObjectRegistry::deregisterObject(Object * object)
     if (object->id() == 0)
         return;
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     m_objects.erase(object);
 }
 
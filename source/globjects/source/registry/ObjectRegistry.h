@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <set>
 
 namespace globjects 
@@ -33,6 +34,8 @@ protected:
     void deregisterObject(Object * object);
 
 protected:
+    // objects of shared contexts are registered from several threads, e.g., by a GLWorkerPool
+    mutable std::mutex m_mutex;
     std::set<Object *> m_objects;
     Framebuffer * m_defaultFBO;
     VertexArray * m_defaultVAO;
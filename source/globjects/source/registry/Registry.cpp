@@ -1,6 +1,10 @@
 #include "Registry.h"
 
+#include <atomic>
+#include <cassert>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <globjects/logging.h>
 
@@ -8,19 +12,35 @@
 #include "ExtensionRegistry.h"
 #include "ImplementationRegistry.h"
 #include "NamedStringRegistry.h"
+#include "StateRegistry.h"
+#include "BindingRegistry.h"
+#include "DeletionRegistry.h"
+#include "NameRegistry.h"
 
 namespace
 {
+    using RegistryMap = std::unordered_map<glbinding::ContextHandle, globjects::Registry *>;
+
     THREAD_LOCAL globjects::Registry * t_currentRegistry;
 
+    // serializes (de)registration only, lookups read the current snapshot without locking
     std::recursive_mutex g_mutex;
+
+    // immutable snapshot of all registries, replaced as a whole on (de)registration (nullptr if empty)
+    std::atomic<const RegistryMap *> g_registries(nullptr);
+
+    // replaced snapshots may still be read by concurrent lookups and are kept until shutdown;
+    // their number is bounded by the number of (de)registrations
+    std::vector<std::unique_ptr<const RegistryMap>> g_retiredRegistries;
+
+    // likewise, registries of deregistered contexts may still be returned by concurrent lookups; they are
+    // kept, without their members, until shutdown (guarded by g_mutex)
+    std::vector<std::unique_ptr<globjects::Registry>> g_retiredContexts;
 }
 
 namespace globjects
 {
 
-std::unordered_map<glbinding::ContextHandle, Registry *> Registry::s_registries;
-
 void Registry::registerContext(glbinding::ContextHandle contextId)
 {
     if (isContextRegistered(contextId))
@@ -38,16 +58,12 @@ void Registry::registerContext(const glbinding::ContextHandle contextId, const g
         globjects::debug() << "OpenGL context " << contextId << " is already registered";
     }
 
-    g_mutex.lock();
-    auto it = s_registries.find(sharedContextId);
-    assert(it != s_registries.end());
-    g_mutex.unlock();
+    Registry * sharedRegistry = find(sharedContextId);
+    assert(sharedRegistry != nullptr);
 
-    Registry * registry = new Registry(it->second);
+    Registry * registry = new Registry(sharedRegistry);
 
-    g_mutex.lock();
-    s_registries[contextId] = registry;
-    g_mutex.unlock();
+    publish(contextId, registry);
 
     t_currentRegistry = registry;
     //registry->initialize();
@@ -55,30 +71,49 @@ void Registry::registerContext(const glbinding::ContextHandle contextId, const g
 
 void Registry::setCurrentContext(const glbinding::ContextHandle contextId)
 {
-    if (!isContextRegistered(contextId))
+    Registry * registry = find(contextId);
+
+    if (registry)
     {
-        globjects::debug() << "Requesting OpenGL context " << contextId << " but it isn't registered yet";
+        t_currentRegistry = registry;
+        return;
     }
 
+    globjects::debug() << "Requesting OpenGL context " << contextId << " but it isn't registered yet";
+
     setCurrentRegistry(contextId);
 }
 
 void Registry::deregisterContext(const glbinding::ContextHandle contextId)
 {
-    if (!isContextRegistered(contextId))
+    Registry * registry = find(contextId);
+
+    if (!registry)
     {
         globjects::debug() << "OpenGL context " << contextId << " is not registered";
 
         return;
     }
 
-    g_mutex.lock();
-    delete s_registries[contextId];
-    g_mutex.unlock();
+    publish(contextId, nullptr);
 
-    g_mutex.lock();
-    s_registries[contextId] = nullptr;
-    g_mutex.unlock();
+    // the pools hold names created without objects, e.g., by glCreate*, which are deleted only with the context otherwise
+    if (registry->isInitialized() && glbinding::getCurrentContext() == contextId)
+    {
+        registry->names().release();
+
+        // the last context of the share group
+        if (registry->m_sharedNames.use_count() == 1)
+            registry->sharedNames().release();
+    }
+
+    registry->retire();
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(g_mutex);
+
+        g_retiredContexts.emplace_back(registry);
+    }
 
     t_currentRegistry = nullptr;
 }
@@ -90,39 +125,76 @@ Registry & Registry::current()
     return *t_currentRegistry;
 }
 
-bool Registry::isContextRegistered(const glbinding::ContextHandle contextId)
+bool Registry::hasCurrent()
 {
-    g_mutex.lock();
-    bool found = s_registries.find(contextId) != s_registries.end();
-    g_mutex.unlock();
+    return t_currentRegistry != nullptr;
+}
 
-    return found;
+bool Registry::isContextRegistered(const glbinding::ContextHandle contextId)
+{
+    return find(contextId) != nullptr;
 }
 
 void Registry::setCurrentRegistry(const glbinding::ContextHandle contextId)
 {
-    g_mutex.lock();
-    auto it = s_registries.find(contextId);
+    Registry * registry = find(contextId);
 
-    if (it != s_registries.end())
+    if (registry)
     {
-        t_currentRegistry = it->second;
-
-        g_mutex.unlock();
+        t_currentRegistry = registry;
+        return;
     }
-    else
+
     {
-        g_mutex.unlock();
+        std::lock_guard<std::recursive_mutex> lock(g_mutex);
 
-        Registry * registry = new Registry();
+        // another thread may have registered the context in the meantime
+        registry = find(contextId);
 
-        g_mutex.lock();
-        s_registries[contextId] = registry;
-        g_mutex.unlock();
+        if (registry)
+        {
+            t_currentRegistry = registry;
+            return;
+        }
 
-        t_currentRegistry = registry;
-        registry->initialize();
+        registry = new Registry();
+
+        publish(contextId, registry);
     }
+
+    t_currentRegistry = registry;
+    registry->initialize();
+}
+
+Registry * Registry::find(const glbinding::ContextHandle contextId)
+{
+    const RegistryMap * registries = g_registries.load(std::memory_order_acquire);
+
+    if (!registries)
+        return nullptr;
+
+    auto it = registries->find(contextId);
+
+    return it != registries->end() ? it->second : nullptr;
+}
+
+void Registry::publish(const glbinding::ContextHandle contextId, Registry * registry)
+{
+    std::lock_guard<std::recursive_mutex> lock(g_mutex);
+
+    const RegistryMap * previous = g_registries.load(std::memory_order_relaxed);
+
+    RegistryMap * registries = previous ? new RegistryMap(*previous) : new RegistryMap;
+
+    if (registry)
+        (*registries)[contextId] = registry;
+    else
+        registries->erase(contextId);
+
+    g_registries.store(registries, std::memory_order_release);
+
+    if (previous)
+        g_retiredRegistries.emplace_back(previous);
 }
 
 Registry::Registry()
@@ -136,11 +208,20 @@ Registry::Registry(Registry * sharedRegistry)
 , m_extensions(sharedRegistry->m_extensions)
 , m_implementations(sharedRegistry->m_implementations)
 , m_namedStrings(sharedRegistry->m_namedStrings)
+, m_states(new StateRegistry)
+, m_bindings(new BindingRegistry)
+, m_deletions(sharedRegistry->m_deletions)
+, m_containerDeletions(new DeletionRegistry)
+, m_names(new NameRegistry)
+, m_sharedNames(sharedRegistry->m_sharedNames)
 {
+    m_deletions->registerBindings(m_bindings.get());
 }
 
 Registry::~Registry()
 {
+    if (m_deletions)
+        m_deletions->deregisterBindings(m_bindings.get());
 }
 
 void Registry::initialize()
@@ -149,10 +230,37 @@ void Registry::initialize()
     m_extensions.reset(new ExtensionRegistry);
     m_namedStrings.reset(new NamedStringRegistry);
     m_implementations.reset(new ImplementationRegistry);
+    m_states.reset(new StateRegistry);
+    m_bindings.reset(new BindingRegistry);
+    m_deletions.reset(new DeletionRegistry);
+    m_containerDeletions.reset(new DeletionRegistry);
+    m_names.reset(new NameRegistry);
+    m_sharedNames.reset(new NameRegistry);
+
+    m_deletions->registerBindings(m_bindings.get());
 
     m_initialized = true;
 }
 
+void Registry::retire()
+{
+    if (m_deletions)
+        m_deletions->deregisterBindings(m_bindings.get());
+
+    m_objects.reset();
+    m_extensions.reset();
+    m_implementations.reset();
+    m_namedStrings.reset();
+    m_states.reset();
+    m_bindings.reset();
+    m_deletions.reset();
+    m_containerDeletions.reset();
+    m_names.reset();
+    m_sharedNames.reset();
+
+    m_initialized = false;
+}
+
 bool Registry::isInitialized() const
 {
     return m_initialized;
@@ -163,6 +271,11 @@ ObjectRegistry & Registry::objects()
     return *m_objects;
 }
 
+const std::shared_ptr<ObjectRegistry> & Registry::sharedObjects() const
+{
+    return m_objects;
+}
+
 ExtensionRegistry & Registry::extensions()
 {
     return *m_extensions;
@@ -178,4 +291,44 @@ NamedStringRegistry & Registry::namedStrings()
     return *m_namedStrings;
 }
 
+StateRegistry & Registry::states()
+{
+    return *m_states;
+}
+
+BindingRegistry & Registry::bindings()
+{
+    return *m_bindings;
+}
+
+DeletionRegistry & Registry::deletions()
+{
+    return *m_deletions;
+}
+
+const std::shared_ptr<DeletionRegistry> & Registry::sharedDeletions() const
+{
+    return m_deletions;
+}
+
+DeletionRegistry & Registry::containerDeletions()
+{
+    return *m_containerDeletions;
+}
+
+const std::shared_ptr<DeletionRegistry> & Registry::sharedContainerDeletions() const
+{
+    return m_containerDeletions;
+}
+
+NameRegistry & Registry::names()
+{
+    return *m_names;
+}
+
+NameRegistry & Registry::sharedNames()
+{
+    return *m_sharedNames;
+}
+
 } // namespace globjects
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <unordered_map>
 #include <memory>
 
 #include <glbinding/ContextHandle.h>
@@ -8,10 +7,14 @@
 namespace globjects
 {
 
+class BindingRegistry;
+class DeletionRegistry;
+class NameRegistry;
 class ObjectRegistry;
 class ExtensionRegistry;
 class ImplementationRegistry;
 class NamedStringRegistry;
+class StateRegistry;
 
 
 class Registry
@@ -19,30 +22,52 @@ class Registry
 public:
     static void registerContext(glbinding::ContextHandle contextId);
     static void registerContext(glbinding::ContextHandle contextId, glbinding::ContextHandle sharedContextId);
+
+    /** \brief Removes the registry of contextId from lookups and releases its members.
+
+        Lookups running concurrently may still obtain the registry; it is kept until shutdown, but must not be used.
+    */
     static void deregisterContext(glbinding::ContextHandle contextId);
 
     static void setCurrentContext(glbinding::ContextHandle contextId);
 
     static Registry & current();
+    static bool hasCurrent();
 
     ObjectRegistry & objects();
+    const std::shared_ptr<ObjectRegistry> & sharedObjects() const;
     ExtensionRegistry & extensions();
     ImplementationRegistry & implementations();
     NamedStringRegistry & namedStrings();
+    StateRegistry & states();
+    BindingRegistry & bindings();
+    DeletionRegistry & deletions();
+    const std::shared_ptr<DeletionRegistry> & sharedDeletions() const;
+    DeletionRegistry & containerDeletions();
+    const std::shared_ptr<DeletionRegistry> & sharedContainerDeletions() const;
+    NameRegistry & names();
+    NameRegistry & sharedNames();
 
     bool isInitialized() const;
 
 private:
+    friend struct std::default_delete<Registry>;
+
     Registry();
     Registry(Registry * sharedRegistry);
     ~Registry();
 
     void initialize();
 
+    /** \brief Releases all registries of the deregistered context; the instance itself is kept for concurrent lookups.
+    */
+    void retire();
+
     static bool isContextRegistered(glbinding::ContextHandle contextId);
     static void setCurrentRegistry(glbinding::ContextHandle contextId);
 
-    static std::unordered_map<glbinding::ContextHandle, Registry *> s_registries;
+    static Registry * find(glbinding::ContextHandle contextId);
+    static void publish(glbinding::ContextHandle contextId, Registry * registry);
 
 private:
     bool m_initialized;
@@ -50,6 +75,12 @@ private:
     std::shared_ptr<ExtensionRegistry> m_extensions;
     std::shared_ptr<ImplementationRegistry> m_implementations;
     std::shared_ptr<NamedStringRegistry> m_namedStrings;
+    std::shared_ptr<StateRegistry> m_states;
+    std::shared_ptr<BindingRegistry> m_bindings;
+    std::shared_ptr<DeletionRegistry> m_deletions;
+    std::shared_ptr<DeletionRegistry> m_containerDeletions;
+    std::shared_ptr<NameRegistry> m_names;
+    std::shared_ptr<NameRegistry> m_sharedNames;
 };
 
 } // namespace globjects
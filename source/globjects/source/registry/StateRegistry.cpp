@@ -0,0 +1,243 @@
+#include "StateRegistry.h"
+#include "Registry.h"
+
+#include <glbinding/gl/functions.h>
+
+using namespace gl;
+
+namespace
+{
+
+template <typename... Arguments>
+void * functionIdentifier(void (*function)(Arguments...))
+{
+    return *reinterpret_cast<void**>(&function);
+}
+
+// settings of standard functions may bypass the StateBlock, e.g., through State::set(); returns the fields they overwrite
+std::uint32_t standardFields(void * identifier)
+{
+    using globjects::StateBlock;
+
+    const auto field = [](const StateBlock::Field field) { return std::uint32_t(1) << field; };
+
+    static const std::unordered_map<void *, std::uint32_t> fields = {
+        { functionIdentifier(glBlendColor), field(StateBlock::BlendColor) },
+        { functionIdentifier(glBlendFunc), field(StateBlock::BlendFunc) },
+        { functionIdentifier(glBlendFuncSeparate), field(StateBlock::BlendFunc) },
+        { functionIdentifier(glClearColor), field(StateBlock::ClearColor) },
+        { functionIdentifier(glClearDepth), field(StateBlock::ClearDepth) },
+        { functionIdentifier(glClearDepthf), field(StateBlock::ClearDepth) },
+        { functionIdentifier(glClearStencil), field(StateBlock::ClearStencil) },
+        { functionIdentifier(glColorMask), field(StateBlock::ColorMask) },
+        { functionIdentifier(glCullFace), field(StateBlock::CullFace) },
+        { functionIdentifier(glDepthFunc), field(StateBlock::DepthFunc) },
+        { functionIdentifier(glDepthMask), field(StateBlock::DepthMask) },
+        { functionIdentifier(glDepthRange), field(StateBlock::DepthRange) },
+        { functionIdentifier(glDepthRangef), field(StateBlock::DepthRange) },
+        { functionIdentifier(glFrontFace), field(StateBlock::FrontFace) },
+        { functionIdentifier(glLogicOp), field(StateBlock::LogicOp) },
+        { functionIdentifier(glPointSize), field(StateBlock::PointSize) },
+        { functionIdentifier(glPolygonMode), field(StateBlock::PolygonModeFront) | field(StateBlock::PolygonModeBack) },
+        { functionIdentifier(glPolygonOffset), field(StateBlock::PolygonOffset) },
+        { functionIdentifier(glPrimitiveRestartIndex), field(StateBlock::PrimitiveRestartIndex) },
+        { functionIdentifier(glProvokingVertex), field(StateBlock::ProvokingVertex) },
+        { functionIdentifier(glSampleCoverage), field(StateBlock::SampleCoverage) },
+        { functionIdentifier(glScissor), field(StateBlock::Scissor) },
+        { functionIdentifier(glStencilFunc), field(StateBlock::StencilFuncFront) | field(StateBlock::StencilFuncBack) },
+        { functionIdentifier(glStencilFuncSeparate), field(StateBlock::StencilFuncFront) | field(StateBlock::StencilFuncBack) },
+        { functionIdentifier(glStencilOp), field(StateBlock::StencilOpFront) | field(StateBlock::StencilOpBack) },
+        { functionIdentifier(glStencilOpSeparate), field(StateBlock::StencilOpFront) | field(StateBlock::StencilOpBack) },
+        { functionIdentifier(glStencilMask), field(StateBlock::StencilMaskFront) | field(StateBlock::StencilMaskBack) },
+        { functionIdentifier(glStencilMaskSeparate), field(StateBlock::StencilMaskFront) | field(StateBlock::StencilMaskBack) }
+    };
+
+    auto it = fields.find(identifier);
+
+    return it == fields.end() ? 0 : it->second;
+}
+
+}
+
+namespace globjects
+{
+
+StateRegistry::StateRegistry()
+: m_tracking(false)
+, m_issued(0)
+, m_elided(0)
+{
+}
+
+StateRegistry::~StateRegistry()
+{
+    invalidate();
+}
+
+StateRegistry & StateRegistry::current()
+{
+    return Registry::current().states();
+}
+
+StateBlock & StateRegistry::block()
+{
+    return m_block;
+}
+
+const StateBlock & StateRegistry::block() const
+{
+    return m_block;
+}
+
+std::vector<StateBlock> & StateRegistry::stack()
+{
+    return m_stack;
+}
+
+const std::unordered_map<GLenum, bool> & StateRegistry::capabilities() const
+{
+    return m_capabilities;
+}
+
+const std::unordered_map<GLenum, std::map<int, bool>> & StateRegistry::indexedCapabilities() const
+{
+    return m_indexedCapabilities;
+}
+
+const std::unordered_map<StateSettingType, StateSetting *> & StateRegistry::settings() const
+{
+    return m_settings;
+}
+
+bool StateRegistry::isTracking() const
+{
+    return m_tracking;
+}
+
+void StateRegistry::setTracking(const bool tracking)
+{
+    m_tracking = tracking;
+}
+
+bool StateRegistry::isCurrent(const GLenum capability, const bool enabled) const
+{
+    if (StateBlock::isStandardCapability(capability))
+        return m_block.isSet(capability) && m_block.isEnabled(capability) == enabled;
+
+    auto it = m_capabilities.find(capability);
+
+    return it != m_capabilities.end() && it->second == enabled;
+}
+
+bool StateRegistry::isCurrent(const GLenum capability, const int index, const bool enabled) const
+{
+    auto it = m_indexedCapabilities.find(capability);
+    if (it == m_indexedCapabilities.end())
+        return false;
+
+    auto indexIt = it->second.find(index);
+
+    return indexIt != it->second.end() && indexIt->second == enabled;
+}
+
+bool StateRegistry::isCurrent(const StateSetting & setting) const
+{
+    auto it = m_settings.find(setting.type());
+
+    return it != m_settings.end() && it->second->equals(setting);
+}
+
+void StateRegistry::setCurrent(const GLenum capability, const bool enabled)
+{
+    if (StateBlock::isStandardCapability(capability))
+        m_block.setEnabled(capability, enabled);
+    else
+        m_capabilities[capability] = enabled;
+
+    // glEnable and glDisable affect all indices
+    auto it = m_indexedCapabilities.find(capability);
+    if (it == m_indexedCapabilities.end())
+        return;
+
+    for (auto & index : it->second)
+        index.second = enabled;
+}
+
+void StateRegistry::setCurrent(const GLenum capability, const int index, const bool enabled)
+{
+    m_indexedCapabilities[capability][index] = enabled;
+
+    // the other indices may differ now
+    m_block.unsetCapability(capability);
+    m_capabilities.erase(capability);
+}
+
+void StateRegistry::setCurrent(const StateSetting & setting)
+{
+    // not shadowed twice, the standard values are forgotten instead
+    const std::uint32_t fields = standardFields(setting.type().functionIdentifier());
+    if (fields)
+    {
+        m_block.unset(fields);
+        return;
+    }
+
+    // settings that can not be copied are not shadowed, their value is unknown
+    StateSetting * current = setting.clone();
+
+    auto it = m_settings.find(setting.type());
+    if (it != m_settings.end())
+    {
+        delete it->second;
+
+        if (current)
+            it->second = current;
+        else
+            m_settings.erase(it);
+    }
+    else if (current)
+    {
+        m_settings[setting.type()] = current;
+    }
+}
+
+void StateRegistry::invalidate()
+{
+    m_block = StateBlock();
+    m_capabilities.clear();
+    m_indexedCapabilities.clear();
+
+    for (const auto & setting : m_settings)
+    {
+        delete setting.second;
+    }
+    m_settings.clear();
+}
+
+void StateRegistry::countIssued(const unsigned long long count)
+{
+    m_issued += count;
+}
+
+void StateRegistry::countElided(const unsigned long long count)
+{
+    m_elided += count;
+}
+
+unsigned long long StateRegistry::issued() const
+{
+    return m_issued;
+}
+
+unsigned long long StateRegistry::elided() const
+{
+    return m_elided;
+}
+
+void StateRegistry::resetCounts()
+{
+    m_issued = 0;
+    m_elided = 0;
+}
+
+} // namespace globjects
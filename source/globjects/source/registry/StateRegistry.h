@@ -0,0 +1,78 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/StateBlock.h>
+#include <globjects/StateSetting.h>
+
+namespace globjects
+{
+
+/** \brief Shadow of the capabilities and settings last set in the current context through globjects.
+
+    Unlike the other registries, it is never shared between contexts, as
+    pipeline state is per context. Values not set through globjects yet are
+    unknown and always considered to differ. Standard values are kept in a
+    StateBlock, the remaining ones per capability and setting type.
+*/
+class StateRegistry
+{
+public:
+    StateRegistry();
+    ~StateRegistry();
+
+    static StateRegistry & current();
+
+    StateBlock & block();
+    const StateBlock & block() const;
+
+    /** \brief Snapshots pushed by StateStack.
+    */
+    std::vector<StateBlock> & stack();
+
+    const std::unordered_map<gl::GLenum, bool> & capabilities() const;
+    const std::unordered_map<gl::GLenum, std::map<int, bool>> & indexedCapabilities() const;
+    const std::unordered_map<StateSettingType, StateSetting *> & settings() const;
+
+    /** \brief Whether currentState() is answered from the shadow instead of querying OpenGL.
+    */
+    bool isTracking() const;
+    void setTracking(bool tracking);
+
+    bool isCurrent(gl::GLenum capability, bool enabled) const;
+    bool isCurrent(gl::GLenum capability, int index, bool enabled) const;
+    bool isCurrent(const StateSetting & setting) const;
+
+    void setCurrent(gl::GLenum capability, bool enabled);
+    void setCurrent(gl::GLenum capability, int index, bool enabled);
+    void setCurrent(const StateSetting & setting);
+
+    /** \brief Forgets all values, e.g., after foreign code changed the context's state.
+    */
+    void invalidate();
+
+    void countIssued(unsigned long long count = 1);
+    void countElided(unsigned long long count = 1);
+
+    unsigned long long issued() const;
+    unsigned long long elided() const;
+    void resetCounts();
+
+protected:
+    bool m_tracking;
+
+    StateBlock m_block;
+    std::vector<StateBlock> m_stack;
+    std::unordered_map<gl::GLenum, bool> m_capabilities;
+    std::unordered_map<gl::GLenum, std::map<int, bool>> m_indexedCapabilities;
+    std::unordered_map<StateSettingType, StateSetting *> m_settings;
+
+    unsigned long long m_issued;
+    unsigned long long m_elided;
+};
+
+} // namespace globjects
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <iostream>
+
+#include <gmock/gmock.h>
+
+#include <glbinding/Binding.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <globjects/globjects.h>
+
+/** Fixture for tests that require a current OpenGL context, provided by a hidden window shared by all tests.
+    Tests return early if no context can be created, e.g., on build machines without display.
+*/
+class ContextTest : public testing::Test
+{
+public:
+    static bool hasContext()
+    {
+        static const bool created = createContext();
+
+        return created;
+    }
+
+protected:
+    static bool createContext()
+    {
+        if (!glfwInit())
+            return false;
+
+        glfwDefaultWindowHints();
+        glfwWindowHint(GLFW_VISIBLE, false);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, true);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        GLFWwindow * window = glfwCreateWindow(1, 1, "", nullptr, nullptr);
+
+        if (!window)
+        {
+            std::cout << "No OpenGL context available, tests requiring one are skipped" << std::endl;
+            return false;
+        }
+
+        glfwMakeContextCurrent(window);
+
+        glbinding::Binding::initialize(false);
+        globjects::init();
+
+        return true;
+    }
+};
@@ -0,0 +1,56 @@
+#include <gmock/gmock.h>
+
+#include <globjects/base/AbstractFunctionCall.h>
+#include <globjects/base/FunctionCall.h>
+
+class FunctionCall_test : public testing::Test
+{
+public:
+};
+
+namespace
+{
+
+void function(int, int)
+{
+}
+
+// user call implementing neither clone() nor equals()
+class CustomCall : public globjects::AbstractFunctionCall
+{
+public:
+    virtual void operator()() override
+    {
+    }
+
+    virtual void * identifier() const override
+    {
+        return nullptr;
+    }
+};
+
+}
+
+TEST_F(FunctionCall_test, CustomCallIsNeitherCopiedNorEqual)
+{
+    CustomCall call;
+
+    EXPECT_EQ(nullptr, call.clone());
+    EXPECT_FALSE(call.equals(call));
+}
+
+TEST_F(FunctionCall_test, ComparesFunctionAndArguments)
+{
+    globjects::FunctionCall<int, int> call(function, 1, 2);
+    globjects::FunctionCall<int, int> same(function, 1, 2);
+    globjects::FunctionCall<int, int> other(function, 1, 3);
+
+    EXPECT_TRUE(call.equals(same));
+    EXPECT_FALSE(call.equals(other));
+
+    globjects::AbstractFunctionCall * copy = call.clone();
+    ASSERT_NE(nullptr, copy);
+    EXPECT_TRUE(copy->equals(call));
+
+    delete copy;
+}
@@ -0,0 +1,95 @@
+#include "ContextTest.h"
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/PipelineState.h>
+#include <globjects/Program.h>
+#include <globjects/Shader.h>
+#include <globjects/StateBlock.h>
+
+using namespace gl;
+
+class PipelineState_test : public ContextTest
+{
+public:
+};
+
+namespace
+{
+
+globjects::Program * createProgram()
+{
+    globjects::Program * program = new globjects::Program();
+    program->attach(
+        globjects::Shader::fromString(GL_VERTEX_SHADER, "#version 150\nvoid main() { gl_Position = vec4(0.0); }"),
+        globjects::Shader::fromString(GL_FRAGMENT_SHADER, "#version 150\nout vec4 color;\nvoid main() { color = vec4(1.0); }"));
+
+    return program;
+}
+
+GLint blendSource()
+{
+    GLint source = 0;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &source);
+
+    return source;
+}
+
+}
+
+TEST_F(PipelineState_test, TransitionRoundTripResetsValuesOfPredecessor)
+{
+    if (!hasContext())
+        return;
+
+    globjects::ref_ptr<globjects::Program> program = createProgram();
+
+    globjects::StateBlock blending;
+    blending.setEnabled(GL_BLEND, true);
+    blending.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    globjects::ref_ptr<globjects::PipelineState> opaque = new globjects::PipelineState(program, nullptr, globjects::StateBlock());
+    globjects::ref_ptr<globjects::PipelineState> transparent = new globjects::PipelineState(program, nullptr, blending);
+
+    opaque->apply();
+
+    transparent->apply(opaque);
+
+    EXPECT_EQ(GL_TRUE, glIsEnabled(GL_BLEND));
+    EXPECT_EQ(static_cast<GLint>(GL_SRC_ALPHA), blendSource());
+
+    opaque->apply(transparent);
+
+    EXPECT_EQ(GL_FALSE, glIsEnabled(GL_BLEND));
+    EXPECT_EQ(static_cast<GLint>(GL_ONE), blendSource());
+
+    // the cached transitions behave the same
+    transparent->apply(opaque);
+    opaque->apply(transparent);
+
+    EXPECT_EQ(GL_FALSE, glIsEnabled(GL_BLEND));
+}
+
+TEST_F(PipelineState_test, ApplyResetsValuesOfShadow)
+{
+    if (!hasContext())
+        return;
+
+    globjects::ref_ptr<globjects::Program> program = createProgram();
+
+    globjects::StateBlock blending;
+    blending.setEnabled(GL_BLEND, true);
+
+    globjects::ref_ptr<globjects::PipelineState> opaque = new globjects::PipelineState(program, nullptr, globjects::StateBlock());
+    globjects::ref_ptr<globjects::PipelineState> transparent = new globjects::PipelineState(program, nullptr, blending);
+
+    transparent->apply();
+    EXPECT_EQ(GL_TRUE, glIsEnabled(GL_BLEND));
+
+    opaque->apply();
+    EXPECT_EQ(GL_FALSE, glIsEnabled(GL_BLEND));
+}
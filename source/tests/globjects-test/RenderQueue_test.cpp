@@ -0,0 +1,163 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/RenderQueue.h>
+
+class RenderQueue_test : public testing::Test
+{
+public:
+};
+
+namespace
+{
+
+// exposes the sort, items are never drawn
+class SortingRenderQueue : public globjects::RenderQueue
+{
+public:
+    using RenderQueue::Key;
+    using RenderQueue::sort;
+
+    std::vector<Key> & keys() { return m_keys; }
+    std::vector<unsigned int> & order() { return m_order; }
+};
+
+// distinct non-null pointers that are never dereferenced
+template <typename T>
+T * fake(const unsigned int index)
+{
+    return reinterpret_cast<T *>(static_cast<std::uintptr_t>(index + 1) * 64);
+}
+
+std::vector<unsigned int> stableOrder(const std::vector<SortingRenderQueue::Key> & keys)
+{
+    std::vector<unsigned int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    std::stable_sort(order.begin(), order.end(), [&keys](const unsigned int a, const unsigned int b)
+    {
+        return keys[a] < keys[b];
+    });
+
+    return order;
+}
+
+void checkSortsLikeStableSort(const unsigned int chunkCount)
+{
+    std::mt19937_64 random(chunkCount);
+
+    globjects::ref_ptr<SortingRenderQueue> queue = new SortingRenderQueue;
+
+    // few distinct upper digits and many duplicates, as produced by compact ids, and fully random keys
+    for (unsigned int i = 0; i < 20000; ++i)
+    {
+        const SortingRenderQueue::Key key = i % 2
+            ? random()
+            : ((random() % 8) << 48) | ((random() % 100) << 16) | (random() % 4);
+
+        queue->keys().push_back(key);
+        queue->order().push_back(i);
+    }
+
+    const std::vector<SortingRenderQueue::Key> keys = queue->keys();
+    const std::vector<unsigned int> expected = stableOrder(keys);
+
+    queue->sort(chunkCount);
+
+    EXPECT_EQ(expected, queue->order());
+    EXPECT_TRUE(std::is_sorted(queue->keys().begin(), queue->keys().end()));
+}
+
+}
+
+TEST_F(RenderQueue_test, RadixSortMatchesStableSortSingleChunk)
+{
+    checkSortsLikeStableSort(1);
+}
+
+TEST_F(RenderQueue_test, RadixSortMatchesStableSortMultipleChunks)
+{
+    checkSortsLikeStableSort(2);
+    checkSortsLikeStableSort(3);
+    checkSortsLikeStableSort(7);
+}
+
+TEST_F(RenderQueue_test, RadixSortHandlesFewerItemsThanChunks)
+{
+    globjects::ref_ptr<SortingRenderQueue> queue = new SortingRenderQueue;
+
+    queue->keys() = { 3, 1, 2 };
+    queue->order() = { 0, 1, 2 };
+
+    queue->sort(8);
+
+    EXPECT_EQ(std::vector<unsigned int>({ 1, 2, 0 }), queue->order());
+}
+
+TEST_F(RenderQueue_test, SortKeyOrdersByProgramStateTexturesVertexArrayAndDepth)
+{
+    using Ids = std::map<unsigned int, unsigned int>;
+    using Expected = std::tuple<unsigned int, unsigned int, unsigned int, unsigned int, unsigned int>;
+
+    // ids in order of first submission, as assigned by the queue
+    const auto compact = [](Ids & ids, const unsigned int index)
+    {
+        return ids.emplace(index, static_cast<unsigned int>(ids.size())).first->second;
+    };
+
+    const float depths[] = { -0.5f, 0.0f, 0.25f, 0.5f, 1.0f, 1.5f };
+
+    std::mt19937 random(0);
+
+    globjects::ref_ptr<SortingRenderQueue> queue = new SortingRenderQueue;
+
+    Ids programIds, stateIds, textureIds, vaoIds;
+    std::vector<Expected> expected;
+
+    for (unsigned int i = 0; i < 500; ++i)
+    {
+        const unsigned int program = random() % 3;
+        const unsigned int state = random() % 3;
+        const unsigned int texture = random() % 4;
+        const unsigned int vao = random() % 3;
+        const float depth = depths[random() % 6];
+
+        globjects::RenderQueue::Item item;
+        item.program = fake<globjects::Program>(program);
+        item.state = state ? fake<globjects::State>(state) : nullptr;
+        item.textures[0] = texture ? fake<globjects::Texture>(texture) : nullptr;
+        item.vao = fake<globjects::VertexArray>(vao);
+        item.depth = depth;
+
+        queue->submit(item);
+
+        const float clamped = std::min(std::max(depth, 0.0f), 1.0f);
+
+        expected.emplace_back(compact(programIds, program), compact(stateIds, state), compact(textureIds, texture)
+            , compact(vaoIds, vao), static_cast<unsigned int>(clamped * 65535));
+    }
+
+    std::vector<unsigned int> expectedOrder(expected.size());
+    std::iota(expectedOrder.begin(), expectedOrder.end(), 0u);
+
+    std::stable_sort(expectedOrder.begin(), expectedOrder.end(), [&expected](const unsigned int a, const unsigned int b)
+    {
+        return expected[a] < expected[b];
+    });
+
+    queue->sort(1);
+
+    EXPECT_EQ(expectedOrder, queue->order());
+
+    // items are not drawn
+    queue->clear();
+}
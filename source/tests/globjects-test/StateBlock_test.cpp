@@ -0,0 +1,234 @@
+#include <gmock/gmock.h>
+
+#include <functional>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/StateBlock.h>
+#include <globjects/StateSetting.h>
+
+using namespace gl;
+
+class StateBlock_test : public testing::Test
+{
+public:
+};
+
+TEST_F(StateBlock_test, IsEmptyByDefault)
+{
+    globjects::StateBlock block;
+
+    EXPECT_TRUE(block.isEmpty());
+    EXPECT_EQ(0u, block.count());
+    EXPECT_EQ(0u, block.fields());
+}
+
+TEST_F(StateBlock_test, SetsFacesSeparately)
+{
+    globjects::StateBlock block;
+    block.stencilMaskSeparate(GL_FRONT_AND_BACK, 0xff);
+    block.polygonMode(GL_BACK, GL_LINE);
+
+    EXPECT_TRUE(block.isSet(globjects::StateBlock::StencilMaskFront));
+    EXPECT_TRUE(block.isSet(globjects::StateBlock::StencilMaskBack));
+    EXPECT_FALSE(block.isSet(globjects::StateBlock::PolygonModeFront));
+    EXPECT_TRUE(block.isSet(globjects::StateBlock::PolygonModeBack));
+    EXPECT_EQ(3u, block.count());
+}
+
+TEST_F(StateBlock_test, ConvertsToSettingsPerFieldAndFace)
+{
+    globjects::StateBlock block;
+    block.setEnabled(GL_BLEND, true);
+    block.depthFunc(GL_LESS);
+    block.stencilOpSeparate(GL_FRONT_AND_BACK, GL_KEEP, GL_KEEP, GL_REPLACE);
+
+    EXPECT_EQ(1u, block.capabilities().size());
+
+    std::vector<globjects::StateSetting *> settings = block.settings();
+    ASSERT_EQ(3u, settings.size());
+
+    // the faces must not replace each other when added to a State
+    EXPECT_FALSE(settings[1]->type() == settings[2]->type());
+
+    for (globjects::StateSetting * setting : settings)
+        delete setting;
+}
+
+TEST_F(StateBlock_test, MergeOverwritesSetFieldsOnly)
+{
+    globjects::StateBlock block;
+    block.depthFunc(GL_LESS);
+    block.cullFace(GL_BACK);
+
+    globjects::StateBlock other;
+    other.depthFunc(GL_GREATER);
+    other.frontFace(GL_CW);
+
+    block.merge(other);
+
+    globjects::StateBlock expected;
+    expected.depthFunc(GL_GREATER);
+    expected.cullFace(GL_BACK);
+    expected.frontFace(GL_CW);
+
+    EXPECT_EQ(expected, block);
+}
+
+TEST_F(StateBlock_test, MergeOverwritesCapabilities)
+{
+    globjects::StateBlock block;
+    block.setEnabled(GL_DEPTH_TEST, true);
+    block.setEnabled(GL_BLEND, true);
+
+    globjects::StateBlock other;
+    other.setEnabled(GL_BLEND, false);
+    other.setEnabled(GL_CULL_FACE, true);
+
+    block.merge(other);
+
+    EXPECT_TRUE(block.isSet(GL_DEPTH_TEST));
+    EXPECT_TRUE(block.isEnabled(GL_DEPTH_TEST));
+    EXPECT_TRUE(block.isSet(GL_BLEND));
+    EXPECT_FALSE(block.isEnabled(GL_BLEND));
+    EXPECT_TRUE(block.isEnabled(GL_CULL_FACE));
+    EXPECT_EQ(3u, block.count());
+}
+
+TEST_F(StateBlock_test, DifferenceContainsChangedValuesOnly)
+{
+    globjects::StateBlock from;
+    from.setEnabled(GL_DEPTH_TEST, true);
+    from.setEnabled(GL_BLEND, false);
+    from.depthFunc(GL_LESS);
+    from.depthMask(GL_TRUE);
+
+    globjects::StateBlock to;
+    to.setEnabled(GL_DEPTH_TEST, true);
+    to.setEnabled(GL_BLEND, true);
+    to.depthFunc(GL_LESS);
+    to.depthMask(GL_FALSE);
+    to.cullFace(GL_BACK);
+
+    const globjects::StateBlock difference = to.difference(from);
+
+    globjects::StateBlock expected;
+    expected.setEnabled(GL_BLEND, true);
+    expected.depthMask(GL_FALSE);
+    expected.cullFace(GL_BACK);
+
+    EXPECT_EQ(expected, difference);
+}
+
+TEST_F(StateBlock_test, DifferenceToItselfIsEmpty)
+{
+    globjects::StateBlock block;
+    block.setEnabled(GL_SCISSOR_TEST, true);
+    block.scissor(0, 0, 640, 480);
+    block.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    EXPECT_TRUE(block.difference(block).isEmpty());
+}
+
+TEST_F(StateBlock_test, EqualBlocksHaveEqualHashes)
+{
+    globjects::StateBlock a;
+    a.depthFunc(GL_LEQUAL);
+    a.setEnabled(GL_DEPTH_TEST, true);
+
+    // set in a different order
+    globjects::StateBlock b;
+    b.setEnabled(GL_DEPTH_TEST, true);
+    b.depthFunc(GL_LEQUAL);
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(std::hash<globjects::StateBlock>()(a), a.hash());
+}
+
+TEST_F(StateBlock_test, DifferentValuesHaveDifferentHashes)
+{
+    globjects::StateBlock a;
+    a.depthFunc(GL_LESS);
+
+    globjects::StateBlock b;
+    b.depthFunc(GL_GREATER);
+
+    globjects::StateBlock c;
+    c.setEnabled(GL_DEPTH_TEST, false);
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(a.hash(), b.hash());
+    EXPECT_NE(globjects::StateBlock().hash(), c.hash());
+}
+
+TEST_F(StateBlock_test, LessIsAStrictWeakOrdering)
+{
+    globjects::StateBlock a;
+    a.depthFunc(GL_LESS);
+
+    globjects::StateBlock b;
+    b.depthFunc(GL_GREATER);
+
+    globjects::StateBlock c;
+    c.depthFunc(GL_LESS);
+    c.cullFace(GL_BACK);
+
+    EXPECT_FALSE(a < a);
+    EXPECT_NE(a < b, b < a);
+    EXPECT_NE(a < c, c < a);
+    EXPECT_NE(b < c, c < b);
+
+    // transitive for the order the three blocks are in
+    const bool ab = a < b;
+    const bool bc = b < c;
+
+    if (ab == bc)
+    {
+        EXPECT_EQ(ab, a < c);
+    }
+}
+
+TEST_F(StateBlock_test, CompletedResetsValuesOnlyPreviousSets)
+{
+    globjects::StateBlock opaque;
+    opaque.setEnabled(GL_DEPTH_TEST, true);
+
+    globjects::StateBlock transparent;
+    transparent.setEnabled(GL_DEPTH_TEST, true);
+    transparent.setEnabled(GL_BLEND, true);
+    transparent.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    transparent.clearColor(1.f, 1.f, 1.f, 1.f);
+
+    // opaque -> transparent -> opaque
+    const globjects::StateBlock forth = transparent.completed(opaque).difference(opaque);
+    const globjects::StateBlock back = opaque.completed(transparent).difference(transparent);
+
+    globjects::StateBlock expectedForth;
+    expectedForth.setEnabled(GL_BLEND, true);
+    expectedForth.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    expectedForth.clearColor(1.f, 1.f, 1.f, 1.f);
+
+    // clear values do not affect drawing and are left as they are
+    globjects::StateBlock expectedBack;
+    expectedBack.setEnabled(GL_BLEND, false);
+    expectedBack.blendFunc(GL_ONE, GL_ZERO);
+
+    EXPECT_EQ(expectedForth, forth);
+    EXPECT_EQ(expectedBack, back);
+    EXPECT_TRUE(opaque.completed(opaque).difference(opaque).isEmpty());
+}
+
+TEST_F(StateBlock_test, DefaultsExcludeContextDependentValues)
+{
+    const globjects::StateBlock & defaults = globjects::StateBlock::defaults();
+
+    EXPECT_TRUE(defaults.isEnabled(GL_DITHER));
+    EXPECT_TRUE(defaults.isSet(GL_BLEND));
+    EXPECT_FALSE(defaults.isEnabled(GL_BLEND));
+    EXPECT_FALSE(defaults.isSet(GL_DEBUG_OUTPUT));
+    EXPECT_FALSE(defaults.isSet(globjects::StateBlock::Scissor));
+    EXPECT_FALSE(defaults.isSet(globjects::StateBlock::ClearColor));
+    EXPECT_TRUE(defaults.isSet(globjects::StateBlock::StencilMaskBack));
+}
@@ -0,0 +1,48 @@
+#include "ContextTest.h"
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/boolean.h>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <globjects/Capability.h>
+#include <globjects/State.h>
+
+using namespace gl;
+
+class State_test : public ContextTest
+{
+public:
+};
+
+TEST_F(State_test, ApplyDiffIssuesCapabilitiesWithoutModifyingDeferredState)
+{
+    if (!hasContext())
+        return;
+
+    globjects::ref_ptr<globjects::State> from = new globjects::State(globjects::State::DeferredMode);
+    from->disable(GL_CLIP_DISTANCE0);
+    from->disable(GL_BLEND, 1);
+
+    globjects::ref_ptr<globjects::State> to = new globjects::State(globjects::State::DeferredMode);
+    to->enable(GL_CLIP_DISTANCE0);
+    to->enable(GL_BLEND, 1);
+
+    globjects::disable(GL_BLEND);
+    from->apply();
+
+    to->applyDiff(*from);
+
+    // the context has the values of to
+    EXPECT_EQ(GL_TRUE, glIsEnabled(GL_CLIP_DISTANCE0));
+    EXPECT_EQ(GL_TRUE, glIsEnabledi(GL_BLEND, 1));
+    EXPECT_EQ(GL_FALSE, glIsEnabledi(GL_BLEND, 0));
+
+    // and to is unchanged, the indexed value did not replace the capability as a whole
+    EXPECT_TRUE(to->isEnabled(GL_CLIP_DISTANCE0));
+    EXPECT_FALSE(to->block().isSet(GL_BLEND));
+    ASSERT_NE(nullptr, to->capability(GL_BLEND));
+    EXPECT_EQ(1u, to->capability(GL_BLEND)->indexEnabled().size());
+    EXPECT_TRUE(to->isEnabled(GL_BLEND, 1));
+}